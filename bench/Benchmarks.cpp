@@ -0,0 +1,603 @@
+// Micro-benchmarks for the sample generation, history and rendering paths.
+//
+// Usage: bench [--filter <substring>] [--min-time <seconds>] [--out <file>]
+//
+// Every benchmark is run with a growing iteration count until one run takes
+// at least --min-time, and is reported per item (sample, push, frame, ...).
+// A human-readable table goes to stderr and the results are written as JSON
+// to --out, or to stdout, so runs can be compared across releases.
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CompositeWave.hpp"
+#include "CoreLogic.hpp"
+#include "Fft.hpp"
+#include "NoiseGenerator.hpp"
+#include "Oscillator.hpp"
+#include "OscillatorBank.hpp"
+#include "RunningStats.hpp"
+#include "ThreadPool.hpp"
+#include "WaveKernels.hpp"
+#include "WaveformGeometry.hpp"
+#include "Wavetable.hpp"
+#include "imgui.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps the compiler from discarding a computed value
+template <typename T>
+inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+const char* WAVE_NAMES[] = {"sine", "cosine", "square", "triangle", "sawtooth"};
+constexpr WaveType WAVE_TYPES[] = {WaveType::SINE, WaveType::COSINE,
+                                   WaveType::SQUARE, WaveType::TRIANGLE,
+                                   WaveType::SAWTOOTH};
+
+struct Result {
+  std::string name;
+  uint64_t iterations = 0;
+  uint64_t items = 0;
+  double seconds = 0.0;
+  std::vector<std::pair<std::string, double>> counters;
+
+  double NsPerItem() const { return items ? seconds * 1e9 / items : 0.0; }
+  double ItemsPerSecond() const { return seconds > 0.0 ? items / seconds : 0.0; }
+};
+
+class Runner {
+ public:
+  std::string filter;
+  double min_time = 0.2;
+  std::vector<Result> results;
+
+  // `body(iterations)` runs the measured work and returns the number of
+  // items it processed
+  using Body = std::function<uint64_t(uint64_t iterations)>;
+
+  Result* Run(const std::string& name, const Body& body) {
+    if (!filter.empty() && name.find(filter) == std::string::npos) return nullptr;
+
+    body(1);  // Warm up caches and lazy initialization
+    Result result;
+    result.name = name;
+    for (uint64_t iterations = 1;; iterations *= 2) {
+      const auto start = Clock::now();
+      const uint64_t items = body(iterations);
+      const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+      if (seconds >= min_time || iterations >= (uint64_t{1} << 40)) {
+        result.iterations = iterations;
+        result.items = items;
+        result.seconds = seconds;
+        break;
+      }
+    }
+    fmt::print(stderr, "{:<44} {:>12.2f} ns/item {:>14.0f} items/s\n", result.name,
+               result.NsPerItem(), result.ItemsPerSecond());
+    results.push_back(std::move(result));
+    return &results.back();
+  }
+};
+
+// Per-sample reference generator, one call per sample
+void BenchGenerateWaveValue(Runner& runner) {
+  for (size_t t = 0; t < std::size(WAVE_TYPES); ++t) {
+    for (bool noise : {false, true}) {
+      CoreLogic core;
+      core.GetWaveType() = WAVE_TYPES[t];
+      core.GetFrequency() = 440.0f;
+      core.GetNoise() = noise ? 0.1f : 0.0f;
+      runner.Run(fmt::format("generate_wave_value/{}{}", WAVE_NAMES[t], noise ? "/noise" : ""),
+                 [&core](uint64_t iterations) {
+                   float sum = 0.0f;
+                   for (uint64_t i = 0; i < iterations; ++i) {
+                     sum += core.GenerateWaveValue(static_cast<float>(i) * (1.0f / 48000.0f));
+                   }
+                   DoNotOptimize(sum);
+                   return iterations;
+                 });
+    }
+  }
+}
+
+// The same signal from compile-time specialized generators, dispatched once
+// per block
+void BenchGenerateWaveBlock(Runner& runner) {
+  constexpr size_t BLOCK = 4096;
+  constexpr double PERIOD = 1.0 / 48000.0;
+  std::vector<float> block(BLOCK);
+  for (size_t t = 0; t < std::size(WAVE_TYPES); ++t) {
+    for (bool noise : {false, true}) {
+      CoreLogic core;
+      core.GetWaveType() = WAVE_TYPES[t];
+      core.GetFrequency() = 440.0f;
+      core.GetNoise() = noise ? 0.1f : 0.0f;
+      runner.Run(fmt::format("generate_wave_block/{}{}", WAVE_NAMES[t], noise ? "/noise" : ""),
+                 [&](uint64_t iterations) {
+                   for (uint64_t i = 0; i < iterations; ++i) {
+                     core.GenerateWaveBlock(static_cast<double>(i * BLOCK) * PERIOD, PERIOD,
+                                            block.data(), BLOCK);
+                     DoNotOptimize(block[0]);
+                   }
+                   return iterations * BLOCK;
+                 });
+    }
+  }
+}
+
+// Batch generation through the phase accumulator and the active kernels
+void BenchGenerateBlock(Runner& runner) {
+  constexpr size_t BLOCK = 4096;
+  std::vector<float> block(BLOCK);
+  for (size_t t = 0; t < std::size(WAVE_TYPES); ++t) {
+    for (bool noise : {false, true}) {
+      WaveParams params;
+      params.wave_type = WAVE_TYPES[t];
+      params.frequency = 440.0f;
+      params.noise = noise ? 0.1f : 0.0f;
+      Oscillator oscillator;
+      runner.Run(fmt::format("generate_block/{}{}", WAVE_NAMES[t], noise ? "/noise" : ""),
+                 [&](uint64_t iterations) {
+                   for (uint64_t i = 0; i < iterations; ++i) {
+                     oscillator.GenerateBlock(params, 48000.0, block.data(), BLOCK);
+                     DoNotOptimize(block[0]);
+                   }
+                   return iterations * BLOCK;
+                 });
+    }
+  }
+}
+
+void BenchCoreLogic(Runner& runner) {
+  CoreLogic core;
+  runner.Run("core_logic/update", [&core](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) core.Update();
+    DoNotOptimize(core.GetVersion());
+    return iterations;
+  });
+
+  // Appending to a full history evicts one sample per push and updates the
+  // ring, the min/max pyramid and the running statistics
+  for (size_t capacity : {size_t{500}, size_t{1} << 20}) {
+    CoreLogic history;
+    history.SetHistoryCapacity(capacity);
+    std::vector<float> block(1024);
+    history.GenerateBlock(block.data(), block.size());
+    while (history.GetSamples().size() < capacity) {
+      history.PushSamples(block.data(), block.size());
+    }
+    runner.Run(fmt::format("history/push_evict/{}", capacity), [&](uint64_t iterations) {
+      for (uint64_t i = 0; i < iterations; ++i) {
+        history.PushSamples(block.data(), block.size());
+      }
+      return iterations * block.size();
+    });
+  }
+}
+
+void BenchStatistics(Runner& runner) {
+  constexpr size_t WINDOW = 100000;
+  std::vector<float> samples(WINDOW);
+  Oscillator oscillator;
+  WaveParams params;
+  params.frequency = 440.0f;
+  params.noise = 0.1f;
+  oscillator.GenerateBlock(params, 48000.0, samples.data(), samples.size());
+
+  RunningStats stats;
+  for (float v : samples) stats.Push(v);
+  runner.Run("stats/push_pop", [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+      const float v = samples[i % WINDOW];
+      stats.Pop(v);
+      stats.Push(v);
+    }
+    DoNotOptimize(stats.GetMax());
+    return iterations;
+  });
+  runner.Run("stats/query", [&](uint64_t iterations) {
+    double sum = 0.0;
+    for (uint64_t i = 0; i < iterations; ++i) {
+      sum += stats.GetMin() + stats.GetMax() + stats.GetMean() + stats.GetStdDev() + stats.GetRms();
+      DoNotOptimize(sum);
+    }
+    return iterations;
+  });
+
+  // Full rescan of the same window, as the status panel used to do
+  runner.Run("stats/rescan/100000", [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+      float lo = samples[0];
+      float hi = samples[0];
+      double sum = 0.0;
+      for (float v : samples) {
+        lo = std::min(lo, v);
+        hi = std::max(hi, v);
+        sum += v;
+      }
+      DoNotOptimize(lo);
+      DoNotOptimize(hi);
+      DoNotOptimize(sum);
+    }
+    return iterations;
+  });
+}
+
+// Every ISA the CPU supports, with the sine/cosine error against std::sin
+void BenchKernels(Runner& runner) {
+  constexpr size_t BLOCK = 4096;
+  constexpr double INCREMENT = 440.0 / 48000.0;
+  std::vector<float> block(BLOCK);
+  const WaveKernels::Isa isas[] = {WaveKernels::Isa::SCALAR, WaveKernels::Isa::SSE2,
+                                   WaveKernels::Isa::AVX2};
+  for (WaveKernels::Isa isa : isas) {
+    if (!WaveKernels::IsSupported(isa)) continue;
+    for (size_t t = 0; t < std::size(WAVE_TYPES); ++t) {
+      WaveKernels::KernelFn kernel = WaveKernels::Get(WAVE_TYPES[t], isa);
+      Result* result = runner.Run(
+          fmt::format("kernels/{}/{}", WaveKernels::IsaName(isa), WAVE_NAMES[t]),
+          [&](uint64_t iterations) {
+            double phase = 0.0;
+            for (uint64_t i = 0; i < iterations; ++i) {
+              kernel(block.data(), BLOCK, phase, INCREMENT, 1.0f);
+              DoNotOptimize(block[0]);
+              phase += BLOCK * INCREMENT;
+              phase -= std::floor(phase);
+            }
+            return iterations * BLOCK;
+          });
+      if (!result) continue;
+      if (WAVE_TYPES[t] != WaveType::SINE && WAVE_TYPES[t] != WaveType::COSINE) continue;
+
+      double max_error = 0.0;
+      constexpr double ODD_INCREMENT = 0.0123456789;
+      kernel(block.data(), BLOCK, 0.0, ODD_INCREMENT, 1.0f);
+      for (size_t i = 0; i < BLOCK; ++i) {
+        const double angle = 2.0 * M_PI * (i * ODD_INCREMENT);
+        const double expected =
+            WAVE_TYPES[t] == WaveType::SINE ? std::sin(angle) : std::cos(angle);
+        max_error = std::max(max_error, std::abs(block[i] - expected));
+      }
+      result->counters.emplace_back("max_error", max_error);
+    }
+  }
+}
+
+// Naive, band-limited and wavetable generation of the shapes with
+// discontinuities, and of the sine as the cost baseline. alias_db is the
+// power of everything but the harmonics below Nyquist, relative to the
+// fundamental, for a 5 kHz tone at 48 kHz.
+void BenchBandLimited(Runner& runner) {
+  constexpr size_t BLOCK = 4096;
+  constexpr double INCREMENT = 440.0 / 48000.0;
+  constexpr size_t FFT_SIZE = 65536;
+  constexpr size_t FUNDAMENTAL_BIN = 6827;  // ~5 kHz, on a bin centre
+  const char* MODE_NAMES[] = {"naive", "polyblep", "wavetable", "wavetable_cubic"};
+  std::vector<float> block(BLOCK);
+  std::vector<float> tone(FFT_SIZE);
+  std::vector<std::complex<float>> bins(FFT_SIZE / 2 + 1);
+  RealFft fft(FFT_SIZE);
+  Wavetable::Prepare();
+
+  for (WaveType type : {WaveType::SINE, WaveType::SQUARE, WaveType::TRIANGLE,
+                        WaveType::SAWTOOTH}) {
+    for (GenerationMode mode : {GenerationMode::NAIVE, GenerationMode::POLYBLEP,
+                                GenerationMode::WAVETABLE_LINEAR,
+                                GenerationMode::WAVETABLE_CUBIC}) {
+      // A sine has nothing to band-limit
+      if (type == WaveType::SINE && mode == GenerationMode::POLYBLEP) continue;
+      WaveKernels::KernelFn kernel = Oscillator::SelectKernel(type, mode);
+      Result* result = runner.Run(
+          fmt::format("bandlimited/{}/{}", WAVE_NAMES[static_cast<int>(type)],
+                      MODE_NAMES[static_cast<int>(mode)]),
+          [&](uint64_t iterations) {
+            double phase = 0.0;
+            for (uint64_t i = 0; i < iterations; ++i) {
+              kernel(block.data(), BLOCK, phase, INCREMENT, 1.0f);
+              DoNotOptimize(block[0]);
+              phase += BLOCK * INCREMENT;
+              phase -= std::floor(phase);
+            }
+            return iterations * BLOCK;
+          });
+      if (!result) continue;
+
+      kernel(tone.data(), FFT_SIZE, 0.0, static_cast<double>(FUNDAMENTAL_BIN) / FFT_SIZE, 1.0f);
+      fft.Forward(tone.data(), bins.data());
+      double alias_power = 0.0;
+      for (size_t k = 1; k < bins.size(); ++k) {
+        if (k % FUNDAMENTAL_BIN != 0) alias_power += std::norm(bins[k]);
+      }
+      result->counters.emplace_back(
+          "alias_db", 10.0 * std::log10(alias_power / std::norm(bins[FUNDAMENTAL_BIN])));
+    }
+  }
+}
+
+// Noise added to a block, against std::mt19937 with a uniform distribution
+void BenchNoise(Runner& runner) {
+  constexpr size_t BLOCK = 4096;
+  std::vector<float> block(BLOCK, 0.0f);
+  for (NoiseType type : {NoiseType::UNIFORM, NoiseType::GAUSSIAN}) {
+    NoiseGenerator noise;
+    runner.Run(fmt::format("noise/{}", type == NoiseType::UNIFORM ? "uniform" : "gaussian"),
+               [&](uint64_t iterations) {
+                 for (uint64_t i = 0; i < iterations; ++i) {
+                   noise.Add(type, block.data(), BLOCK, 1e-3f);
+                   DoNotOptimize(block[0]);
+                 }
+                 return iterations * BLOCK;
+               });
+  }
+  std::mt19937 gen(1);
+  std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
+  runner.Run("noise/mt19937", [&](uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; ++i) {
+      for (size_t j = 0; j < BLOCK; ++j) block[j] += 1e-3f * dis(gen);
+      DoNotOptimize(block[0]);
+    }
+    return iterations * BLOCK;
+  });
+}
+
+// Additive synthesis of inharmonic partials with the rotating phasor bank,
+// against one std::sin per partial and sample. One item is one output
+// sample; realtime is how many 48 kHz streams one core sustains. block is
+// the block size, since the phasors are set up once per block.
+void BenchComposite(Runner& runner) {
+  constexpr double RATE = 48000.0;
+  constexpr double INCREMENT = 110.0 / RATE;
+  for (size_t count : {size_t{16}, size_t{64}, size_t{256}}) {
+    std::vector<Partial> partials;
+    for (size_t p = 0; p < count; ++p) {
+      partials.push_back({1.0f + 0.37f * static_cast<float>(p), 1.0f / static_cast<float>(p + 1),
+                          0.1f * static_cast<float>(p)});
+    }
+    const CompositeWave wave(partials);
+    for (size_t block_size : {size_t{48}, size_t{4096}}) {
+      std::vector<float> block(block_size);
+      Result* result = runner.Run(
+          fmt::format("composite/phasors/{}/{}", count, block_size), [&](uint64_t iterations) {
+            double phase = 0.0;
+            for (uint64_t i = 0; i < iterations; ++i) {
+              wave.Render(block.data(), block_size, phase, INCREMENT, 1.0f);
+              DoNotOptimize(block[0]);
+              phase += block_size * INCREMENT;
+            }
+            return iterations * block_size;
+          });
+      if (result) result->counters.emplace_back("realtime", 1e9 / RATE / result->NsPerItem());
+    }
+
+    Result* result = runner.Run(fmt::format("composite/sin/{}", count), [&](uint64_t iterations) {
+      float sum = 0.0f;
+      for (uint64_t i = 0; i < iterations; ++i) {
+        const double phase = static_cast<double>(i) * INCREMENT;
+        for (const Partial& partial : wave.GetPartials()) {
+          sum += partial.amplitude *
+                 static_cast<float>(std::sin(2.0 * M_PI * partial.ratio * phase + partial.phase));
+        }
+      }
+      DoNotOptimize(sum);
+      return iterations;
+    });
+    if (result) result->counters.emplace_back("realtime", 1e9 / RATE / result->NsPerItem());
+  }
+}
+
+// Aggregate throughput of the oscillator bank (one item = one sample of one
+// channel), on the calling thread alone and spread over the worker pool
+void BenchOscillatorBank(Runner& runner) {
+  constexpr size_t BLOCK = 4096;
+  ThreadPool pool;
+  for (size_t channels : {size_t{16}, size_t{256}, size_t{1024}}) {
+    OscillatorBank bank;
+    bank.Resize(channels);
+    std::vector<float> out(channels * BLOCK);
+    for (bool threaded : {false, true}) {
+      Result* result = runner.Run(
+          fmt::format("bank/{}/{}", threaded ? "pool" : "serial", channels),
+          [&](uint64_t iterations) {
+            for (uint64_t i = 0; i < iterations; ++i) {
+              bank.GenerateBlock(48000.0, out.data(), BLOCK, BLOCK, threaded ? &pool : nullptr);
+              DoNotOptimize(out[0]);
+            }
+            return iterations * channels * BLOCK;
+          });
+      if (result) {
+        result->counters.emplace_back("threads", threaded ? pool.GetWorkerCount() + 1 : 1);
+      }
+    }
+  }
+}
+
+// Cost of the modulation matrix: a bank where every odd channel is a carrier
+// modulated by the channel before it, against the same bank without routes.
+// One item = one sample of one channel, on the calling thread.
+void BenchModulation(Runner& runner) {
+  constexpr size_t CHANNELS = 64;
+  constexpr size_t BLOCK = 256;  // ChannelBank's modulated block
+  const char* TARGET_NAMES[] = {"frequency", "amplitude", "phase"};
+  std::vector<float> out(CHANNELS * BLOCK);
+  for (int target = -1; target < 3; ++target) {
+    OscillatorBank bank;
+    bank.Resize(CHANNELS);
+    if (target >= 0) {
+      for (uint32_t c = 0; c + 1 < CHANNELS; c += 2) {
+        bank.GetModulation().AddRoute({c, c + 1, static_cast<ModTarget>(target), 0.5f});
+      }
+    }
+    Result* result = runner.Run(
+        fmt::format("modulation/{}/{}", target < 0 ? "none" : TARGET_NAMES[target], CHANNELS),
+        [&](uint64_t iterations) {
+          for (uint64_t i = 0; i < iterations; ++i) {
+            bank.GenerateBlock(48000.0, out.data(), BLOCK, BLOCK, nullptr);
+            DoNotOptimize(out[0]);
+          }
+          return iterations * CHANNELS * BLOCK;
+        });
+    if (result) {
+      result->counters.emplace_back("routes", static_cast<double>(bank.GetModulation().GetRoutes().size()));
+    }
+  }
+}
+
+// Vertex generation of the waveform panel into an off-screen ImGui draw
+// list: one new sample, the geometry rebuild, and the two glow passes plus
+// the main line, per frame
+void BenchVisualization(Runner& runner) {
+  ImGui::CreateContext();
+  ImGuiIO& io = ImGui::GetIO();
+  io.DisplaySize = ImVec2(1920.0f, 1080.0f);
+  io.DeltaTime = 1.0f / 60.0f;
+  io.IniFilename = nullptr;
+  unsigned char* pixels = nullptr;
+  int width = 0;
+  int height = 0;
+  io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+  const ImVec2 canvas_pos(0.0f, 0.0f);
+  const ImVec2 canvas_size(1200.0f, 600.0f);
+  const float center_y = canvas_size.y * 0.5f;
+  const float scale_y = canvas_size.y * 0.4f / 10.0f;
+
+  for (size_t capacity : {size_t{500}, size_t{50000}, size_t{5000000}}) {
+    CoreLogic core;
+    core.GetFrequency() = 5.0f;
+    core.GetAmplitude() = 5.0f;
+    core.SetHistoryCapacity(capacity);
+    core.Advance(capacity);
+
+    WaveformGeometry geometry;
+    int vertices = 0;
+    Result* result = runner.Run(
+        fmt::format("visualization/polyline/{}", capacity), [&](uint64_t iterations) {
+          for (uint64_t i = 0; i < iterations; ++i) {
+            core.Advance(1);
+            ImGui::NewFrame();
+            ImGui::SetNextWindowPos(canvas_pos);
+            ImGui::SetNextWindowSize(io.DisplaySize);
+            ImGui::Begin("Bench", nullptr, ImGuiWindowFlags_NoDecoration);
+            ImDrawList* draw_list = ImGui::GetWindowDrawList();
+            const std::vector<ImVec2>& points = geometry.Build(
+                core.GetSamples(), core.GetPyramid(), canvas_pos, canvas_size, center_y, scale_y);
+            const int count = static_cast<int>(points.size());
+            draw_list->AddPolyline(points.data(), count, IM_COL32(66, 150, 250, 40),
+                                   ImDrawFlags_None, 2.0f);
+            draw_list->AddPolyline(points.data(), count, IM_COL32(66, 150, 250, 20),
+                                   ImDrawFlags_None, 3.5f);
+            draw_list->AddPolyline(points.data(), count, IM_COL32(66, 150, 250, 255),
+                                   ImDrawFlags_None, 2.0f);
+            vertices = draw_list->VtxBuffer.Size;
+            ImGui::End();
+            ImGui::Render();
+          }
+          return iterations;
+        });
+    if (result) result->counters.emplace_back("vertices", vertices);
+  }
+
+  ImGui::DestroyContext();
+}
+
+std::string EscapeJson(const std::string& text) {
+  std::string out;
+  for (char c : text) {
+    if (c == '"' || c == '\\') out += '\\';
+    out += c;
+  }
+  return out;
+}
+
+void WriteJson(std::FILE* file, const std::vector<Result>& results) {
+  char date[32];
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+  fmt::print(file, "{{\n  \"context\": {{\n");
+  fmt::print(file, "    \"date\": \"{}\",\n", date);
+  fmt::print(file, "    \"simd\": \"{}\",\n", WaveKernels::IsaName(WaveKernels::ActiveIsa()));
+#if defined(__clang__)
+  fmt::print(file, "    \"compiler\": \"clang {}\"\n", __clang_version__);
+#elif defined(__GNUC__)
+  fmt::print(file, "    \"compiler\": \"gcc {}\"\n", __VERSION__);
+#else
+  fmt::print(file, "    \"compiler\": \"unknown\"\n");
+#endif
+  fmt::print(file, "  }},\n  \"benchmarks\": [\n");
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    fmt::print(file,
+               "    {{\"name\": \"{}\", \"iterations\": {}, \"items\": {}, "
+               "\"ns_per_item\": {}, \"items_per_second\": {}",
+               EscapeJson(r.name), r.iterations, r.items, r.NsPerItem(), r.ItemsPerSecond());
+    for (const auto& [key, value] : r.counters) {
+      fmt::print(file, ", \"{}\": {}", key, value);
+    }
+    fmt::print(file, "}}{}\n", i + 1 < results.size() ? "," : "");
+  }
+  fmt::print(file, "  ]\n}}\n");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  Runner runner;
+  std::string out;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--filter" && i + 1 < argc) {
+      runner.filter = argv[++i];
+    } else if (arg == "--min-time" && i + 1 < argc) {
+      runner.min_time = std::atof(argv[++i]);
+    } else if (arg == "--out" && i + 1 < argc) {
+      out = argv[++i];
+    } else {
+      fmt::print(stderr, "Usage: bench [--filter <substring>] [--min-time <s>] [--out <file>]\n");
+      return 2;
+    }
+  }
+
+  BenchCoreLogic(runner);
+  BenchGenerateWaveValue(runner);
+  BenchGenerateWaveBlock(runner);
+  BenchGenerateBlock(runner);
+  BenchStatistics(runner);
+  BenchKernels(runner);
+  BenchBandLimited(runner);
+  BenchNoise(runner);
+  BenchComposite(runner);
+  BenchOscillatorBank(runner);
+  BenchModulation(runner);
+  BenchVisualization(runner);
+
+  std::FILE* file = out.empty() ? stdout : std::fopen(out.c_str(), "w");
+  if (!file) {
+    fmt::print(stderr, "Failed to open {}\n", out);
+    return 1;
+  }
+  WriteJson(file, runner.results);
+  if (file != stdout) std::fclose(file);
+  return 0;
+}
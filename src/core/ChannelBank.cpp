@@ -0,0 +1,97 @@
+#include "ChannelBank.hpp"
+
+#include <algorithm>
+
+#include "ThreadPool.hpp"
+#include "Trace.hpp"
+
+ChannelBank::ChannelBank() {
+  Resize(DEFAULT_CHANNELS, DEFAULT_HISTORY_CAPACITY);
+}
+
+void ChannelBank::Resize(size_t channels, size_t history_capacity) {
+  channels = std::min(channels, OscillatorBank::MAX_CHANNELS);
+  if (history_capacity != history_capacity_) {
+    channels_.clear();
+    history_capacity_ = history_capacity;
+  }
+  oscillators_.Resize(channels);
+  const size_t old_count = channels_.size();
+  channels_.resize(channels);
+  for (size_t c = old_count; c < channels; ++c) {
+    channels_[c].history.Reset(history_capacity_);
+    channels_[c].pyramid.Reset(history_capacity_);
+  }
+  ++version_;
+}
+
+void ChannelBank::Advance(size_t count, double sample_rate, ThreadPool* pool) {
+  if (count == 0 || channels_.empty()) return;
+  TRACE_SCOPE("ChannelBank::Advance");
+  if (!oscillators_.GetModulation().IsEmpty()) {
+    AdvanceModulated(count, sample_rate, pool);
+    return;
+  }
+
+  auto advance = [&](size_t begin, size_t end) {
+    // One scratch block per worker, reused across calls
+    thread_local std::vector<float> block;
+    block.resize(std::min(count, BLOCK_SIZE));
+    for (size_t c = begin; c < end; ++c) {
+      Channel& channel = channels_[c];
+      for (size_t done = 0; done < count; done += block.size()) {
+        const size_t n = std::min(block.size(), count - done);
+        oscillators_.GenerateChannel(c, sample_rate, block.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+          channel.history.Push(block[i]);
+          channel.pyramid.Push(block[i]);
+        }
+      }
+    }
+  };
+  const size_t grain = OscillatorBank::TaskGrain(count);
+  if (pool) {
+    pool->ParallelFor(channels_.size(), grain, advance);
+  } else {
+    advance(0, channels_.size());
+  }
+
+  total_samples_ += count;
+  ++version_;
+}
+
+void ChannelBank::AdvanceModulated(size_t count, double sample_rate,
+                                   ThreadPool* pool) {
+  const size_t block = std::min(count, MODULATED_BLOCK_SIZE);
+  modulated_block_.resize(channels_.size() * block);
+  for (size_t done = 0; done < count; done += block) {
+    const size_t n = std::min(block, count - done);
+    oscillators_.GenerateBlock(sample_rate, modulated_block_.data(), n, block,
+                               pool);
+    auto append = [&](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        Channel& channel = channels_[c];
+        const float* samples = modulated_block_.data() + c * block;
+        for (size_t i = 0; i < n; ++i) {
+          channel.history.Push(samples[i]);
+          channel.pyramid.Push(samples[i]);
+        }
+      }
+    };
+    const size_t grain = OscillatorBank::TaskGrain(n);
+    if (pool) {
+      pool->ParallelFor(channels_.size(), grain, append);
+    } else {
+      append(0, channels_.size());
+    }
+  }
+
+  total_samples_ += count;
+  ++version_;
+}
+
+SampleView ChannelBank::GetSamples(size_t channel) const {
+  const RingBuffer<float>& history = channels_[channel].history;
+  return {history.FirstSegment(), history.SecondSegment(),
+          version_ * OscillatorBank::MAX_CHANNELS + channel};
+}
@@ -0,0 +1,168 @@
+#include "CompositeWave.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+constexpr size_t LANES = 4;
+constexpr size_t GROUP = 2 * LANES;
+
+// Audible partials as structure-of-arrays phasors, padded to whole groups
+// with silent partials
+struct PhasorBank {
+  alignas(16) float re[CompositeWave::MAX_PARTIALS];
+  alignas(16) float im[CompositeWave::MAX_PARTIALS];
+  alignas(16) float step_re[CompositeWave::MAX_PARTIALS];
+  alignas(16) float step_im[CompositeWave::MAX_PARTIALS];
+  alignas(16) float amplitude[CompositeWave::MAX_PARTIALS];
+  uint16_t source[CompositeWave::MAX_PARTIALS];  // Index into the partials
+  size_t count = 0;   // Audible partials
+  size_t padded = 0;  // count rounded up to GROUP
+};
+
+#if defined(__SSE2__)
+
+// Four partials as one vector of phasors
+struct Lanes {
+  __m128 re, im, wr, wi, a;
+
+  Lanes(const PhasorBank& bank, size_t g)
+      : re(_mm_load_ps(bank.re + g)),
+        im(_mm_load_ps(bank.im + g)),
+        wr(_mm_load_ps(bank.step_re + g)),
+        wi(_mm_load_ps(bank.step_im + g)),
+        a(_mm_load_ps(bank.amplitude + g)) {}
+
+  // Current value, then advance one sample
+  __m128 Next() {
+    const __m128 value = _mm_mul_ps(a, im);
+    const __m128 r = _mm_sub_ps(_mm_mul_ps(re, wr), _mm_mul_ps(im, wi));
+    im = _mm_add_ps(_mm_mul_ps(re, wi), _mm_mul_ps(im, wr));
+    re = r;
+    return value;
+  }
+};
+
+// out[0, length) += sum over the partials of amplitude * im, advancing the
+// phasors one sample per output. Two groups of four partials run side by
+// side, so the multiply latency of one phasor chain overlaps the other.
+void Accumulate(PhasorBank& bank, float* out, size_t length) {
+  const size_t whole = length & ~(LANES - 1);
+  for (size_t g = 0; g < bank.padded; g += GROUP) {
+    Lanes x(bank, g);
+    Lanes y(bank, g + LANES);
+    size_t i = 0;
+    for (; i < whole; i += LANES) {
+      // Row k holds sample i + k of the partials; after the transpose the
+      // column sums are four consecutive outputs
+      __m128 v0 = _mm_add_ps(x.Next(), y.Next());
+      __m128 v1 = _mm_add_ps(x.Next(), y.Next());
+      __m128 v2 = _mm_add_ps(x.Next(), y.Next());
+      __m128 v3 = _mm_add_ps(x.Next(), y.Next());
+      _MM_TRANSPOSE4_PS(v0, v1, v2, v3);
+      const __m128 sum = _mm_add_ps(_mm_add_ps(v0, v1), _mm_add_ps(v2, v3));
+      _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), sum));
+    }
+    for (; i < length; ++i) {
+      alignas(16) float lanes[LANES];
+      _mm_store_ps(lanes, _mm_add_ps(x.Next(), y.Next()));
+      out[i] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+  }
+}
+
+#else
+
+void Accumulate(PhasorBank& bank, float* out, size_t length) {
+  for (size_t p = 0; p < bank.count; ++p) {
+    float re = bank.re[p];
+    float im = bank.im[p];
+    const float wr = bank.step_re[p];
+    const float wi = bank.step_im[p];
+    const float a = bank.amplitude[p];
+    for (size_t i = 0; i < length; ++i) {
+      out[i] += a * im;
+      const float r = re * wr - im * wi;
+      im = re * wi + im * wr;
+      re = r;
+    }
+  }
+}
+
+#endif
+
+}  // namespace
+
+CompositeWave::CompositeWave(std::vector<Partial> partials)
+    : partials_(std::move(partials)) {
+  if (partials_.size() > MAX_PARTIALS) partials_.resize(MAX_PARTIALS);
+  for (Partial& partial : partials_) {
+    const double scale = std::ldexp(1.0, RATIO_BITS);
+    partial.ratio = static_cast<float>(
+        std::round(std::clamp(partial.ratio, 0.f, MAX_RATIO) * scale) / scale);
+    peak_ += std::fabs(partial.amplitude);
+  }
+}
+
+std::vector<Partial> CompositeWave::HarmonicSeries(size_t count, size_t step) {
+  std::vector<Partial> partials(std::min(count, MAX_PARTIALS));
+  for (size_t i = 0; i < partials.size(); ++i) {
+    const float ratio = static_cast<float>(1 + i * step);
+    partials[i] = {ratio, 1.f / ratio, 0.f};
+  }
+  return partials;
+}
+
+void CompositeWave::Render(float* out, size_t n, double phase,
+                           double increment, float amplitude) const {
+  std::fill(out, out + n, 0.f);
+  if (n == 0) return;
+
+  PhasorBank bank;
+  for (size_t p = 0; p < partials_.size(); ++p) {
+    const Partial& partial = partials_[p];
+    const double rotation = partial.ratio * increment;
+    if (std::abs(rotation) >= 0.5 || partial.amplitude == 0.f) continue;
+    const size_t j = bank.count++;
+    bank.step_re[j] = static_cast<float>(std::cos(2.0 * M_PI * rotation));
+    bank.step_im[j] = static_cast<float>(std::sin(2.0 * M_PI * rotation));
+    bank.amplitude[j] = amplitude * partial.amplitude;
+    bank.source[j] = static_cast<uint16_t>(p);
+  }
+  bank.padded = (bank.count + GROUP - 1) & ~(GROUP - 1);
+  for (size_t j = bank.count; j < bank.padded; ++j) {
+    bank.re[j] = 1.f;
+    bank.im[j] = 0.f;
+    bank.step_re[j] = 1.f;
+    bank.step_im[j] = 0.f;
+    bank.amplitude[j] = 0.f;
+  }
+  if (bank.count == 0) return;
+
+  for (size_t start = 0; start < n; start += ANCHOR_INTERVAL) {
+    const double anchor = phase + increment * static_cast<double>(start);
+    for (size_t j = 0; j < bank.count; ++j) {
+      const Partial& partial = partials_[bank.source[j]];
+      double cycles = partial.ratio * anchor + partial.phase / (2.0 * M_PI);
+      cycles -= std::floor(cycles);
+      bank.re[j] = static_cast<float>(std::cos(2.0 * M_PI * cycles));
+      bank.im[j] = static_cast<float>(std::sin(2.0 * M_PI * cycles));
+    }
+    Accumulate(bank, out + start, std::min(ANCHOR_INTERVAL, n - start));
+  }
+}
+
+float CompositeWave::Evaluate(double phase) const {
+  double sum = 0.0;
+  for (const Partial& partial : partials_) {
+    sum += partial.amplitude *
+           std::sin(2.0 * M_PI * partial.ratio * phase + partial.phase);
+  }
+  return static_cast<float>(sum);
+}
@@ -1,24 +1,84 @@
 #include "CoreLogic.hpp"
 
 #include <fmt/core.h>
-#include <random>
 
-CoreLogic::CoreLogic() {
-  sine_wave_values_.clear();
-  time_ = 0.f;
+#include <algorithm>
+#include <memory>
+
+#include "Generator.hpp"
+#include "Trace.hpp"
+
+CoreLogic::CoreLogic()
+    : composite_(std::make_shared<const CompositeWave>(
+          CompositeWave::HarmonicSeries(DEFAULT_PARTIALS))),
+      sine_wave_values_(DEFAULT_HISTORY_CAPACITY) {
+  pyramid_.Reset(DEFAULT_HISTORY_CAPACITY);
+}
+
+void CoreLogic::SetHistoryCapacity(size_t capacity) {
+  capacity =
+      std::clamp(capacity, MIN_HISTORY_CAPACITY, MAX_HISTORY_CAPACITY);
+  if (capacity == sine_wave_values_.Capacity()) return;
+  sine_wave_values_.Reset(capacity);
+  pyramid_.Reset(capacity);
+  stats_.Reset();
+  ++version_;
+}
+
+void CoreLogic::SetNoiseSeed(uint64_t seed) {
+  noise_seed_ = seed;
+  oscillator_.Seed(seed);
+  reference_noise_.Seed(seed);
+}
+
+void CoreLogic::SetPartials(std::vector<Partial> partials) {
+  composite_ = std::make_shared<const CompositeWave>(std::move(partials));
+}
+
+void CoreLogic::AddSink(SampleSink* sink) {
+  if (std::find(sinks_.begin(), sinks_.end(), sink) == sinks_.end()) {
+    sinks_.push_back(sink);
+  }
+}
+
+void CoreLogic::RemoveSink(SampleSink* sink) {
+  sinks_.erase(std::remove(sinks_.begin(), sinks_.end(), sink), sinks_.end());
 }
 
 void CoreLogic::Update() {
+  TRACE_SCOPE("CoreLogic::Update");
   // Assuming ~60 FPS or 1/60 of a sec
-  time_ += 1 / fps_;
-  float value = GenerateWaveValue(time_);
-  sine_wave_values_.push_back(value);
-  if (sine_wave_values_.size() > MAX_VALUES) {
-    sine_wave_values_.erase(sine_wave_values_.begin());
+  Advance(1);
+}
+
+void CoreLogic::Advance(size_t count) {
+  if (count == 0) return;
+  TRACE_SCOPE("CoreLogic::Advance");
+  block_buffer_.resize(count);
+  GenerateBlock(block_buffer_.data(), count);
+  PushSamples(block_buffer_.data(), count);
+}
+
+void CoreLogic::PushSamples(const float* values, size_t count) {
+  if (count == 0) return;
+  TRACE_SCOPE("CoreLogic::PushSamples");
+  for (size_t i = 0; i < count; ++i) {
+    // The statistics need the sample that is about to be overwritten
+    if (sine_wave_values_.Full()) stats_.Pop(sine_wave_values_.Front());
+    sine_wave_values_.Push(values[i]);
+    pyramid_.Push(values[i]);
+    stats_.Push(values[i]);
   }
+  for (SampleSink* sink : sinks_) sink->OnSamples(values, count, total_samples_);
+  total_samples_ += count;
+  ++version_;
 }
 
-float CoreLogic::GenerateWaveValue(float time) const {
+void CoreLogic::GenerateBlock(float* out, size_t n) {
+  oscillator_.GenerateBlock(GetParameters(), fps_, out, n);
+}
+
+float CoreLogic::GenerateWaveValue(float time) {
   float base_value = 0.0f;
   float adjusted_time = 2.0f * M_PI * frequency_ * time + phase_;
   
@@ -52,6 +112,9 @@ float CoreLogic::GenerateWaveValue(float time) const {
         base_value = 2.0f * normalized - 1.0f;
       }
       break;
+    case WaveType::COMPOSITE:
+      base_value = composite_->Evaluate(adjusted_time / (2.0f * M_PI));
+      break;
   }
   
   // Apply amplitude
@@ -59,11 +122,15 @@ float CoreLogic::GenerateWaveValue(float time) const {
   
   // Add noise if enabled
   if (noise_ > 0.0f) {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> dis(-1.0f, 1.0f);
-    base_value += noise_ * amplitude_ * dis(gen);
+    base_value += noise_ * amplitude_ * reference_noise_.Next(noise_type_);
   }
   
   return base_value;
-}
\ No newline at end of file
+}
+
+void CoreLogic::GenerateWaveBlock(double start_time, double sample_period,
+                                  float* out, size_t n) {
+  // One dispatch per block instead of a switch and a test per sample
+  const GeneratorFn generate = SelectGenerator(wave_type_, noise_ > 0.0f);
+  generate(GetParameters(), start_time, sample_period, reference_noise_, out, n);
+}
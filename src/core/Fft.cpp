@@ -0,0 +1,86 @@
+#include "Fft.hpp"
+
+#include <cmath>
+#include <numbers>
+#include <utility>
+
+namespace {
+
+// std::complex multiplication carries NaN/Inf recovery code; the inputs here
+// are always finite
+inline std::complex<float> Mul(std::complex<float> a, std::complex<float> b) {
+  return {a.real() * b.real() - a.imag() * b.imag(),
+          a.real() * b.imag() + a.imag() * b.real()};
+}
+
+}  // namespace
+
+RealFft::RealFft(size_t size) {
+  if (size > 0) Resize(size);
+}
+
+void RealFft::Resize(size_t size) {
+  if (size == size_) return;
+  size_ = size;
+  const size_t half = size / 2;
+
+  // Twiddles are computed in double so large sizes keep full float accuracy
+  twiddles_.resize(half / 2);
+  for (size_t k = 0; k < twiddles_.size(); ++k) {
+    const double angle = -2.0 * std::numbers::pi * k / half;
+    twiddles_[k] = {static_cast<float>(std::cos(angle)),
+                    static_cast<float>(std::sin(angle))};
+  }
+  split_twiddles_.resize(half + 1);
+  for (size_t k = 0; k <= half; ++k) {
+    const double angle = -2.0 * std::numbers::pi * k / size;
+    split_twiddles_[k] = {static_cast<float>(std::cos(angle)),
+                          static_cast<float>(std::sin(angle))};
+  }
+
+  size_t bits = 0;
+  while ((size_t{1} << bits) < half) ++bits;
+  bit_reverse_.resize(half);
+  for (size_t i = 0; i < half; ++i) {
+    size_t reversed = 0;
+    for (size_t b = 0; b < bits; ++b) reversed |= ((i >> b) & 1) << (bits - 1 - b);
+    bit_reverse_[i] = reversed;
+  }
+  work_.resize(half);
+}
+
+void RealFft::Forward(const float* in, std::complex<float>* out) {
+  const size_t half = size_ / 2;
+  std::complex<float>* z = work_.data();
+
+  // Pack even/odd samples as one complex sequence, in bit-reversed order
+  for (size_t i = 0; i < half; ++i) {
+    const size_t j = bit_reverse_[i];
+    z[j] = {in[2 * i], in[2 * i + 1]};
+  }
+
+  // Iterative decimation-in-time butterflies
+  for (size_t length = 2; length <= half; length <<= 1) {
+    const size_t span = length / 2;
+    const size_t stride = half / length;
+    for (size_t start = 0; start < half; start += length) {
+      for (size_t k = 0; k < span; ++k) {
+        const std::complex<float> u = z[start + k];
+        const std::complex<float> v = Mul(z[start + k + span], twiddles_[k * stride]);
+        z[start + k] = u + v;
+        z[start + k + span] = u - v;
+      }
+    }
+  }
+
+  // Split the packed spectrum into the spectra of the even and odd samples
+  // and combine them: X[k] = E[k] + exp(-2 pi i k / N) O[k]
+  for (size_t k = 0; k <= half; ++k) {
+    const std::complex<float> a = z[k == half ? 0 : k];
+    const std::complex<float> b = std::conj(z[k == 0 ? 0 : half - k]);
+    const std::complex<float> even = 0.5f * (a + b);
+    const std::complex<float> odd =
+        std::complex<float>(0.f, -0.5f) * (a - b);
+    out[k] = even + Mul(split_twiddles_[k], odd);
+  }
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "NoiseGenerator.hpp"
+#include "Oscillator.hpp"
+#include "WaveKernelsDetail.hpp"
+#include "WaveType.hpp"
+
+// Compile-time specialized block generators behind
+// CoreLogic::GenerateWaveBlock(), internal to the core translation units.
+//
+// Generator<TYPE, HAS_NOISE> produces the signal of
+// CoreLogic::GenerateWaveValue() for a run of equally spaced times, with the
+// wave type and the noise test resolved by the template instead of per
+// sample. The shape loop has no branches and no loop-carried state: the
+// phase of each sample is computed from its index and wrapped by
+// truncation, and the shapes are built from truncation, min, abs and
+// polynomials, so the loop
+// inlines completely and vectorizes. Phase is re-anchored in double
+// precision every CHUNK samples, which keeps the float offsets within a
+// chunk small and gives the vectorizer a fixed trip count (GCC's -O2 cost
+// model only vectorizes loops that need no scalar epilogue).
+
+// Unit shapes; x is the phase in cycles, in [0, 1)
+template <WaveType TYPE>
+struct WaveShape;
+
+namespace GeneratorDetail {
+
+// Integer part of a non-negative x. Steps of the shapes are written with it
+// rather than with comparisons, which GCC at -O2 does not turn into vector
+// selects.
+inline float Truncate(float x) {
+  return static_cast<float>(static_cast<int32_t>(x));
+}
+
+inline float SinCycles(float x) {
+  using namespace WaveKernels::detail;
+  const float y = x - Truncate(x + 0.5f);  // [-0.5, 0.5)
+  const float a = std::fabs(y);
+  const float q = std::copysign(std::min(a, 0.5f - a), y);  // Quarter wave
+  const float q2 = q * q;
+  float r = SIN_C9 + q2 * SIN_C11;
+  r = SIN_C7 + q2 * r;
+  r = SIN_C5 + q2 * r;
+  r = SIN_C3 + q2 * r;
+  r = SIN_C1 + q2 * r;
+  return q * r;
+}
+
+inline float QuarterShift(float x) {
+  const float y = x + 0.25f;
+  return y - Truncate(y);
+}
+
+}  // namespace GeneratorDetail
+
+template <>
+struct WaveShape<WaveType::SINE> {
+  static float Eval(float x) { return GeneratorDetail::SinCycles(x); }
+};
+template <>
+struct WaveShape<WaveType::COSINE> {
+  static float Eval(float x) {
+    return GeneratorDetail::SinCycles(GeneratorDetail::QuarterShift(x));
+  }
+};
+template <>
+struct WaveShape<WaveType::SQUARE> {
+  static float Eval(float x) {
+    return 1.0f - 2.0f * GeneratorDetail::Truncate(x + 0.5f);
+  }
+};
+template <>
+struct WaveShape<WaveType::TRIANGLE> {
+  static float Eval(float x) {
+    return 1.0f - 4.0f * std::fabs(GeneratorDetail::QuarterShift(x) - 0.5f);
+  }
+};
+template <>
+struct WaveShape<WaveType::SAWTOOTH> {
+  static float Eval(float x) { return 2.0f * x - 1.0f; }
+};
+
+template <WaveType TYPE, bool HAS_NOISE>
+struct Generator {
+  static constexpr size_t CHUNK = 16;
+
+  // Samples at start_time + i * sample_period (seconds) for i in [0, n).
+  // The generation mode of `params` is ignored; the shapes are naive.
+  static void Generate(const WaveParams& params, double start_time,
+                       double sample_period, NoiseGenerator& noise,
+                       float* out, size_t n) {
+    double phase = params.frequency * start_time + params.phase / (2.0 * M_PI);
+    double increment = params.frequency * sample_period;
+    phase -= std::floor(phase);
+    increment -= std::floor(increment);
+    const double chunk_increment = increment * CHUNK;
+    const float step = static_cast<float>(increment);
+
+    size_t i = 0;
+    for (; i + CHUNK <= n; i += CHUNK) {
+      Chunk(out + i, static_cast<float>(phase), step, params.amplitude);
+      phase += chunk_increment;
+      phase -= std::floor(phase);
+    }
+    if (i < n) {
+      float tail[CHUNK];
+      Chunk(tail, static_cast<float>(phase), step, params.amplitude);
+      std::copy_n(tail, n - i, out + i);
+    }
+
+    if constexpr (HAS_NOISE) {
+      noise.Add(params.noise_type, out, n, params.noise * params.amplitude);
+    }
+  }
+
+ private:
+  // Fixed trip count and a 32-bit index, which converts to float in one
+  // vector instruction
+  static void Chunk(float* out, float first, float step, float amplitude) {
+    for (int32_t k = 0; k < static_cast<int32_t>(CHUNK); ++k) {
+      float x = first + static_cast<float>(k) * step;
+      x -= GeneratorDetail::Truncate(x);
+      out[k] = amplitude * WaveShape<TYPE>::Eval(x);
+    }
+  }
+};
+
+// Composite waves sum their partials with CompositeWave::Render(), which is
+// already a block loop; this only adds the once-per-block dispatch
+template <bool HAS_NOISE>
+struct CompositeGenerator {
+  static void Generate(const WaveParams& params, double start_time,
+                       double sample_period, NoiseGenerator& noise,
+                       float* out, size_t n) {
+    if (!params.composite) {
+      Generator<WaveType::SINE, HAS_NOISE>::Generate(params, start_time,
+                                                     sample_period, noise, out, n);
+      return;
+    }
+    const double phase =
+        params.frequency * start_time + params.phase / (2.0 * M_PI);
+    params.composite->Render(out, n, phase, params.frequency * sample_period,
+                             params.amplitude);
+    if constexpr (HAS_NOISE) {
+      noise.Add(params.noise_type, out, n, params.noise * params.amplitude);
+    }
+  }
+};
+
+using GeneratorFn = void (*)(const WaveParams& params, double start_time,
+                             double sample_period, NoiseGenerator& noise,
+                             float* out, size_t n);
+
+template <bool HAS_NOISE>
+GeneratorFn SelectGenerator(WaveType type) {
+  switch (type) {
+    case WaveType::SINE:
+      return Generator<WaveType::SINE, HAS_NOISE>::Generate;
+    case WaveType::COSINE:
+      return Generator<WaveType::COSINE, HAS_NOISE>::Generate;
+    case WaveType::SQUARE:
+      return Generator<WaveType::SQUARE, HAS_NOISE>::Generate;
+    case WaveType::TRIANGLE:
+      return Generator<WaveType::TRIANGLE, HAS_NOISE>::Generate;
+    case WaveType::SAWTOOTH:
+      return Generator<WaveType::SAWTOOTH, HAS_NOISE>::Generate;
+    case WaveType::COMPOSITE:
+      return CompositeGenerator<HAS_NOISE>::Generate;
+  }
+  return Generator<WaveType::SINE, HAS_NOISE>::Generate;
+}
+
+// The specialization for one block
+inline GeneratorFn SelectGenerator(WaveType type, bool has_noise) {
+  return has_noise ? SelectGenerator<true>(type) : SelectGenerator<false>(type);
+}
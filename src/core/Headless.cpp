@@ -0,0 +1,274 @@
+#include "Headless.hpp"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "SampleRecorder.hpp"
+
+namespace {
+
+constexpr size_t BLOCK_FRAMES = 1 << 16;
+constexpr size_t DEFAULT_PARTIALS = 8;
+
+void PrintUsage() {
+  fmt::print(stderr,
+             "Usage: sine-simulator --headless [options]\n"
+             "  --wave <sine|cosine|square|triangle|sawtooth|composite>  (default sine)\n"
+             "  --partials <ratio:amp[:phase],...>  Partials of the composite wave\n"
+             "                       (default 8 harmonics at amplitude 1/n)\n"
+             "  --freq <Hz>          Frequency (default 1)\n"
+             "  --amp <value>        Amplitude (default 1)\n"
+             "  --phase <rad>        Phase offset (default 0)\n"
+             "  --noise <value>      Noise relative to amplitude (default 0)\n"
+             "  --noise-type <uniform|gaussian>  Noise distribution (default uniform)\n"
+             "  --seed <n>           Noise seed (default fixed)\n"
+             "  --generation <naive|polyblep|wavetable|wavetable-cubic>\n"
+             "                       Generation mode; all but naive are\n"
+             "                       band-limited (default naive)\n"
+             "  --rate <Hz>          Sample rate (default 48000)\n"
+             "  --duration <s>       Length in seconds (default 10)\n"
+             "  --format <pcm16|pcm24|float>  WAV sample format (default pcm16)\n"
+             "  --out <path>         .wav, .csv, raw float32 otherwise, - for stdout\n");
+}
+
+bool ParseNumber(std::string_view name, const char* text, double& value) {
+  char* end = nullptr;
+  value = std::strtod(text, &end);
+  if (end == text || *end != '\0' || !std::isfinite(value)) {
+    fmt::print(stderr, "Invalid value for {}: {}\n", name, text);
+    return false;
+  }
+  return true;
+}
+
+// Comma-separated ratio:amplitude[:phase] triples
+bool ParsePartials(const char* text, std::vector<Partial>& partials) {
+  partials.clear();
+  const char* p = text;
+  while (*p != '\0') {
+    Partial partial;
+    float* fields[] = {&partial.ratio, &partial.amplitude, &partial.phase};
+    size_t count = 0;
+    while (count < std::size(fields)) {
+      char* end = nullptr;
+      const double value = std::strtod(p, &end);
+      if (end == p || !std::isfinite(value)) break;
+      *fields[count++] = static_cast<float>(value);
+      p = end;
+      if (*p != ':') break;
+      ++p;
+    }
+    if (count < 2 || (*p != ',' && *p != '\0') ||
+        partials.size() == CompositeWave::MAX_PARTIALS) {
+      fmt::print(stderr, "Invalid value for --partials: {}\n", text);
+      return false;
+    }
+    partials.push_back(partial);
+    if (*p == ',') ++p;
+  }
+  return !partials.empty();
+}
+
+bool EndsWith(std::string_view text, std::string_view suffix) {
+  return text.size() >= suffix.size() &&
+         text.substr(text.size() - suffix.size()) == suffix;
+}
+
+// CSV and raw float32 output; WAV goes through RenderWavFile
+bool WriteStream(const HeadlessOptions& options, bool csv, uint64_t& frames) {
+  const bool to_stdout = options.out == "-";
+  std::FILE* file = to_stdout ? stdout : std::fopen(options.out.c_str(), "wb");
+  if (!file) return false;
+
+  Oscillator oscillator(options.seed);
+  std::vector<float> block(BLOCK_FRAMES);
+  std::vector<char> text;
+  if (csv) text.assign(CSV_HEADER, CSV_HEADER + std::strlen(CSV_HEADER));
+
+  uint64_t remaining = static_cast<uint64_t>(
+      std::llround(options.duration * options.sample_rate));
+  frames = 0;
+  bool ok = true;
+  while (remaining > 0 && ok) {
+    const size_t n = static_cast<size_t>(std::min<uint64_t>(remaining, BLOCK_FRAMES));
+    oscillator.GenerateBlock(options.params, options.sample_rate, block.data(), n);
+    if (csv) {
+      FormatCsvRows(block.data(), n, frames, options.sample_rate, text);
+      ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+      text.clear();
+    } else {
+      ok = std::fwrite(block.data(), sizeof(float), n, file) == n;
+    }
+    frames += n;
+    remaining -= n;
+  }
+
+  if (to_stdout) return std::fflush(file) == 0 && ok;
+  return std::fclose(file) == 0 && ok;
+}
+
+}  // namespace
+
+bool IsHeadlessRequested(int argc, char* argv[]) {
+  for (int i = 1; i < argc; ++i) {
+    if (std::string_view(argv[i]) == "--headless") return true;
+  }
+  return false;
+}
+
+bool ParseHeadlessOptions(int argc, char* argv[], HeadlessOptions& options) {
+  const char* waveNames[] = {"sine", "cosine", "square", "triangle", "sawtooth",
+                             "composite"};
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg == "--headless") continue;
+    if (arg == "--help" || arg == "-h") return false;
+    if (i + 1 >= argc) {
+      fmt::print(stderr, "Unknown option or missing value: {}\n", arg);
+      return false;
+    }
+    const char* value = argv[++i];
+    double number = 0.0;
+
+    if (arg == "--wave") {
+      auto it = std::find_if(std::begin(waveNames), std::end(waveNames),
+                             [value](const char* name) { return std::strcmp(name, value) == 0; });
+      if (it == std::end(waveNames)) {
+        fmt::print(stderr, "Unknown wave type: {}\n", value);
+        return false;
+      }
+      options.params.wave_type = static_cast<WaveType>(it - std::begin(waveNames));
+    } else if (arg == "--format") {
+      const std::string_view format = value;
+      if (format == "pcm16") {
+        options.format = WavFormat::PCM16;
+      } else if (format == "pcm24") {
+        options.format = WavFormat::PCM24;
+      } else if (format == "float") {
+        options.format = WavFormat::FLOAT32;
+      } else {
+        fmt::print(stderr, "Unknown WAV format: {}\n", format);
+        return false;
+      }
+    } else if (arg == "--noise-type") {
+      const std::string_view type = value;
+      if (type == "uniform") {
+        options.params.noise_type = NoiseType::UNIFORM;
+      } else if (type == "gaussian") {
+        options.params.noise_type = NoiseType::GAUSSIAN;
+      } else {
+        fmt::print(stderr, "Unknown noise type: {}\n", type);
+        return false;
+      }
+    } else if (arg == "--generation") {
+      const std::string_view mode = value;
+      if (mode == "naive") {
+        options.params.generation = GenerationMode::NAIVE;
+      } else if (mode == "polyblep") {
+        options.params.generation = GenerationMode::POLYBLEP;
+      } else if (mode == "wavetable") {
+        options.params.generation = GenerationMode::WAVETABLE_LINEAR;
+      } else if (mode == "wavetable-cubic") {
+        options.params.generation = GenerationMode::WAVETABLE_CUBIC;
+      } else {
+        fmt::print(stderr, "Unknown generation mode: {}\n", mode);
+        return false;
+      }
+    } else if (arg == "--seed") {
+      char* end = nullptr;
+      options.seed = std::strtoull(value, &end, 0);
+      if (end == value || *end != '\0') {
+        fmt::print(stderr, "Invalid value for {}: {}\n", arg, value);
+        return false;
+      }
+    } else if (arg == "--partials") {
+      std::vector<Partial> partials;
+      if (!ParsePartials(value, partials)) return false;
+      options.params.composite = std::make_shared<const CompositeWave>(std::move(partials));
+    } else if (arg == "--out") {
+      options.out = value;
+    } else if (arg == "--freq") {
+      if (!ParseNumber(arg, value, number)) return false;
+      options.params.frequency = static_cast<float>(number);
+    } else if (arg == "--amp") {
+      if (!ParseNumber(arg, value, number)) return false;
+      options.params.amplitude = static_cast<float>(number);
+    } else if (arg == "--phase") {
+      if (!ParseNumber(arg, value, number)) return false;
+      options.params.phase = static_cast<float>(number);
+    } else if (arg == "--noise") {
+      if (!ParseNumber(arg, value, number)) return false;
+      options.params.noise = static_cast<float>(std::max(number, 0.0));
+    } else if (arg == "--rate") {
+      if (!ParseNumber(arg, value, number)) return false;
+      if (number < 1.0 || number > 4294967295.0) {
+        fmt::print(stderr, "Sample rate out of range: {}\n", value);
+        return false;
+      }
+      options.sample_rate = static_cast<uint32_t>(number);
+    } else if (arg == "--duration") {
+      if (!ParseNumber(arg, value, number)) return false;
+      if (number < 0.0) {
+        fmt::print(stderr, "Duration must not be negative: {}\n", value);
+        return false;
+      }
+      options.duration = number;
+    } else {
+      fmt::print(stderr, "Unknown option: {}\n", arg);
+      return false;
+    }
+  }
+
+  if (options.out.empty()) {
+    fmt::print(stderr, "Missing --out\n");
+    return false;
+  }
+  if (!options.params.composite) {
+    options.params.composite = std::make_shared<const CompositeWave>(
+        CompositeWave::HarmonicSeries(DEFAULT_PARTIALS));
+  }
+  return true;
+}
+
+int RunHeadless(int argc, char* argv[]) {
+  HeadlessOptions options;
+  if (!ParseHeadlessOptions(argc, argv, options)) {
+    PrintUsage();
+    return 2;
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  uint64_t frames = 0;
+  bool ok = false;
+  if (EndsWith(options.out, ".wav")) {
+    WavRenderStats stats;
+    ok = RenderWavFile(options.out, options.params, options.sample_rate,
+                       options.duration, options.format, &stats, options.seed);
+    frames = stats.frames;
+  } else {
+    ok = WriteStream(options, EndsWith(options.out, ".csv"), frames);
+  }
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+
+  if (!ok) {
+    fmt::print(stderr, "Failed to write {}\n", options.out);
+    return 1;
+  }
+  fmt::print(stderr, "Wrote {} samples to {} in {:.3f} s ({:.1f} M samples/s)\n",
+             frames, options.out, seconds,
+             seconds > 0.0 ? frames / seconds / 1e6 : 0.0);
+  return 0;
+}
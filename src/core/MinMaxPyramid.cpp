@@ -0,0 +1,92 @@
+#include "MinMaxPyramid.hpp"
+
+#include <algorithm>
+
+namespace {
+
+inline void Merge(MinMax& into, MinMax value) {
+  into.min = std::min(into.min, value.min);
+  into.max = std::max(into.max, value.max);
+}
+
+}  // namespace
+
+void MinMaxPyramid::Reset(size_t history_capacity) {
+  levels_.clear();
+  total_ = 0;
+  for (size_t block_size = BASE_BLOCK; block_size <= history_capacity;
+       block_size *= FANOUT) {
+    Level level;
+    // Enough blocks to cover the history plus the partially evicted and the
+    // partially filled block at either end
+    level.blocks.resize(history_capacity / block_size + 2);
+    level.block_size = block_size;
+    levels_.push_back(std::move(level));
+  }
+}
+
+void MinMaxPyramid::Push(float value) {
+  ++total_;
+  if (!levels_.empty()) Accumulate(0, {value, value});
+}
+
+void MinMaxPyramid::Accumulate(size_t level, MinMax value) {
+  Level& lv = levels_[level];
+  if (lv.pending_count == 0) {
+    lv.pending = value;
+  } else {
+    Merge(lv.pending, value);
+  }
+
+  const size_t fill = level == 0 ? BASE_BLOCK : FANOUT;
+  if (++lv.pending_count < fill) return;
+
+  lv.blocks[lv.completed % lv.blocks.size()] = lv.pending;
+  ++lv.completed;
+  lv.pending_count = 0;
+  if (level + 1 < levels_.size()) Accumulate(level + 1, lv.pending);
+}
+
+MinMax MinMaxPyramid::Query(const SampleView& view, size_t first,
+                            size_t last) const {
+  last = std::min(last, view.size());
+  if (first >= last) return {0.f, 0.f};
+
+  // Work in absolute sample indices, which is what the block numbers use
+  const uint64_t view_start = total_ - view.size();
+  MinMax result{view[first], view[first]};
+  QueryLevel(static_cast<int>(levels_.size()) - 1, view, view_start,
+             view_start + first, view_start + last, result);
+  return result;
+}
+
+void MinMaxPyramid::QueryLevel(int level, const SampleView& view,
+                               uint64_t view_start, uint64_t first,
+                               uint64_t last, MinMax& result) const {
+  if (first >= last) return;
+
+  if (level < 0) {
+    for (uint64_t i = first; i < last; ++i) {
+      float v = view[static_cast<size_t>(i - view_start)];
+      Merge(result, {v, v});
+    }
+    return;
+  }
+
+  // Complete blocks of this level that lie entirely inside [first, last)
+  const Level& lv = levels_[level];
+  const uint64_t size = lv.block_size;
+  const uint64_t first_block = (first + size - 1) / size;
+  const uint64_t end_block = std::min<uint64_t>(last / size, lv.completed);
+  if (first_block >= end_block) {
+    QueryLevel(level - 1, view, view_start, first, last, result);
+    return;
+  }
+
+  for (uint64_t block = first_block; block < end_block; ++block) {
+    Merge(result, lv.blocks[block % lv.blocks.size()]);
+  }
+  // Ragged edges are resolved by the finer levels
+  QueryLevel(level - 1, view, view_start, first, first_block * size, result);
+  QueryLevel(level - 1, view, view_start, end_block * size, last, result);
+}
@@ -0,0 +1,25 @@
+#include "ModulationMatrix.hpp"
+
+bool ModulationMatrix::AddRoute(const ModRoute& route) {
+  if (routes_.size() >= MAX_ROUTES) return false;
+  routes_.push_back(route);
+  return true;
+}
+
+void ModulationMatrix::RemoveRoute(size_t index) {
+  if (index < routes_.size()) routes_.erase(routes_.begin() + index);
+}
+
+void ModulationMatrix::Accumulate(const float* source, float depth, float* sum,
+                                  size_t n) {
+  // Fixed-size chunks staged through a local array, which GCC at -O2
+  // vectorizes without proving that the buffers don't overlap
+  constexpr size_t CHUNK = 16;
+  float scaled[CHUNK];
+  size_t i = 0;
+  for (; i + CHUNK <= n; i += CHUNK) {
+    for (size_t j = 0; j < CHUNK; ++j) scaled[j] = depth * source[i + j];
+    for (size_t j = 0; j < CHUNK; ++j) sum[i + j] += scaled[j];
+  }
+  for (; i < n; ++i) sum[i] += depth * source[i];
+}
@@ -0,0 +1,244 @@
+#include "NoiseGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <initializer_list>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+uint64_t SplitMix64(uint64_t& state) {
+  uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+
+inline uint32_t Rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+inline float BitsToFloat(uint32_t bits) {
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+inline uint32_t FloatToBits(float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+// Top 24 bits as a value in [-1, 1); the low bits of xoshiro128+ are its
+// weakest
+inline float ToSignedUnit(uint32_t x) {
+  return static_cast<float>(static_cast<int32_t>(x) >> 8) * 0x1p-23f;
+}
+
+// Natural log for x in (0, 1]: exponent plus a series in
+// t = (m - 1) / (m + 1) for the mantissa m in [1, 2); error below 1e-6
+inline float FastLog(float x) {
+  const uint32_t bits = FloatToBits(x);
+  const float exponent = static_cast<float>(static_cast<int32_t>(bits >> 23) - 127);
+  const float m = BitsToFloat((bits & 0x007FFFFFu) | 0x3F800000u);
+  const float t = (m - 1.f) / (m + 1.f);
+  const float t2 = t * t;
+  const float series =
+      t * (2.f + t2 * (2.f / 3.f + t2 * (2.f / 5.f + t2 * (2.f / 7.f + t2 * (2.f / 9.f)))));
+  return exponent * 0.69314718f + series;
+}
+
+// sin and cos of x in [-pi/2, pi/2], Taylor to degree 11 and 10
+inline float SinHalfPi(float x) {
+  const float x2 = x * x;
+  return x * (1.f + x2 * (-1.f / 6 + x2 * (1.f / 120 + x2 * (-1.f / 5040 +
+         x2 * (1.f / 362880 + x2 * (-1.f / 39916800))))));
+}
+
+inline float CosHalfPi(float x) {
+  const float x2 = x * x;
+  return 1.f + x2 * (-0.5f + x2 * (1.f / 24 + x2 * (-1.f / 720 +
+         x2 * (1.f / 40320 + x2 * (-1.f / 3628800)))));
+}
+
+#if defined(__SSE2__)
+
+// The same steps on four lanes at a time
+
+inline __m128i Sse2Rotl(__m128i x, int k) {
+  return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32 - k));
+}
+
+inline __m128i Sse2Next(__m128i& s0, __m128i& s1, __m128i& s2, __m128i& s3) {
+  const __m128i result = _mm_add_epi32(s0, s3);
+  const __m128i t = _mm_slli_epi32(s1, 9);
+  s2 = _mm_xor_si128(s2, s0);
+  s3 = _mm_xor_si128(s3, s1);
+  s1 = _mm_xor_si128(s1, s2);
+  s0 = _mm_xor_si128(s0, s3);
+  s2 = _mm_xor_si128(s2, t);
+  s3 = Sse2Rotl(s3, 11);
+  return result;
+}
+
+inline __m128 Sse2ToSignedUnit(__m128i x) {
+  return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(x, 8)), _mm_set1_ps(0x1p-23f));
+}
+
+inline __m128 Sse2Poly(__m128 x, std::initializer_list<float> coefficients) {
+  // Horner from the highest coefficient down
+  const float* c = coefficients.end();
+  __m128 r = _mm_set1_ps(*--c);
+  while (c != coefficients.begin()) {
+    r = _mm_add_ps(_mm_mul_ps(r, x), _mm_set1_ps(*--c));
+  }
+  return r;
+}
+
+inline __m128 Sse2FastLog(__m128 x) {
+  const __m128i bits = _mm_castps_si128(x);
+  const __m128 exponent = _mm_cvtepi32_ps(
+      _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)));
+  const __m128 m = _mm_castsi128_ps(
+      _mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)),
+                   _mm_set1_epi32(0x3F800000)));
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 t = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+  const __m128 series = _mm_mul_ps(
+      t, Sse2Poly(_mm_mul_ps(t, t), {2.f, 2.f / 3.f, 2.f / 5.f, 2.f / 7.f, 2.f / 9.f}));
+  return _mm_add_ps(_mm_mul_ps(exponent, _mm_set1_ps(0.69314718f)), series);
+}
+
+#endif
+
+}  // namespace
+
+void NoiseGenerator::Seed(uint64_t seed, uint64_t stream) {
+  uint64_t state = seed ^ (stream * 0xD1B54A32D192ED03ull);
+  for (size_t l = 0; l < LANES; ++l) {
+    const uint64_t a = SplitMix64(state);
+    const uint64_t b = SplitMix64(state);
+    s0_[l] = static_cast<uint32_t>(a);
+    s1_[l] = static_cast<uint32_t>(a >> 32);
+    s2_[l] = static_cast<uint32_t>(b);
+    s3_[l] = static_cast<uint32_t>(b >> 32);
+    // xoshiro must not start from the all-zero state
+    if ((a | b) == 0) s0_[l] = 1;
+  }
+  buffered_ = 0;
+}
+
+void NoiseGenerator::NextRaw(uint32_t* out) {
+  for (size_t l = 0; l < LANES; ++l) {
+    out[l] = s0_[l] + s3_[l];
+    const uint32_t t = s1_[l] << 9;
+    s2_[l] ^= s0_[l];
+    s3_[l] ^= s1_[l];
+    s1_[l] ^= s2_[l];
+    s0_[l] ^= s3_[l];
+    s2_[l] ^= t;
+    s3_[l] = Rotl(s3_[l], 11);
+  }
+}
+
+void NoiseGenerator::NextBatch(float* out, NoiseType type) {
+#if defined(__SSE2__)
+  for (size_t l = 0; l < LANES; l += 4) {
+    __m128i s0 = _mm_load_si128(reinterpret_cast<const __m128i*>(s0_ + l));
+    __m128i s1 = _mm_load_si128(reinterpret_cast<const __m128i*>(s1_ + l));
+    __m128i s2 = _mm_load_si128(reinterpret_cast<const __m128i*>(s2_ + l));
+    __m128i s3 = _mm_load_si128(reinterpret_cast<const __m128i*>(s3_ + l));
+    const __m128i a = Sse2Next(s0, s1, s2, s3);
+    const __m128i b = Sse2Next(s0, s1, s2, s3);
+    _mm_store_si128(reinterpret_cast<__m128i*>(s0_ + l), s0);
+    _mm_store_si128(reinterpret_cast<__m128i*>(s1_ + l), s1);
+    _mm_store_si128(reinterpret_cast<__m128i*>(s2_ + l), s2);
+    _mm_store_si128(reinterpret_cast<__m128i*>(s3_ + l), s3);
+
+    if (type == NoiseType::UNIFORM) {
+      _mm_storeu_ps(out + l, Sse2ToSignedUnit(a));
+      _mm_storeu_ps(out + LANES + l, Sse2ToSignedUnit(b));
+      continue;
+    }
+
+    // See the scalar version below
+    const __m128 u1 = _mm_mul_ps(
+        _mm_cvtepi32_ps(_mm_add_epi32(_mm_srli_epi32(a, 8), _mm_set1_epi32(1))),
+        _mm_set1_ps(0x1p-24f));
+    const __m128 angle = _mm_mul_ps(Sse2ToSignedUnit(b), _mm_set1_ps(1.57079633f));
+    const __m128 sign = _mm_castsi128_ps(
+        _mm_slli_epi32(_mm_and_si128(b, _mm_set1_epi32(0x80)), 24));
+    const __m128 radius = _mm_xor_ps(
+        _mm_sqrt_ps(_mm_mul_ps(_mm_set1_ps(-2.f), Sse2FastLog(u1))), sign);
+    const __m128 x2 = _mm_mul_ps(angle, angle);
+    const __m128 cosine = Sse2Poly(
+        x2, {1.f, -0.5f, 1.f / 24, -1.f / 720, 1.f / 40320, -1.f / 3628800});
+    const __m128 sine = _mm_mul_ps(
+        angle, Sse2Poly(x2, {1.f, -1.f / 6, 1.f / 120, -1.f / 5040, 1.f / 362880,
+                             -1.f / 39916800}));
+    _mm_storeu_ps(out + l, _mm_mul_ps(radius, cosine));
+    _mm_storeu_ps(out + LANES + l, _mm_mul_ps(radius, sine));
+  }
+#else
+  alignas(32) uint32_t a[LANES];
+  alignas(32) uint32_t b[LANES];
+  NextRaw(a);
+  NextRaw(b);
+  if (type == NoiseType::UNIFORM) {
+    for (size_t l = 0; l < LANES; ++l) {
+      out[l] = ToSignedUnit(a[l]);
+      out[LANES + l] = ToSignedUnit(b[l]);
+    }
+    return;
+  }
+
+  // Box-Muller on a half circle: the angle covers [-pi/2, pi/2) and a
+  // spare bit of `b` picks the half, which keeps the polynomials short
+  for (size_t l = 0; l < LANES; ++l) {
+    const float u1 = static_cast<float>((a[l] >> 8) + 1) * 0x1p-24f;  // (0, 1]
+    const float angle = ToSignedUnit(b[l]) * 1.57079633f;
+    const float sign = (b[l] & 0x80u) ? -1.f : 1.f;
+    const float radius = sign * std::sqrt(-2.f * FastLog(u1));
+    out[l] = radius * CosHalfPi(angle);
+    out[LANES + l] = radius * SinHalfPi(angle);
+  }
+#endif
+}
+
+void NoiseGenerator::Fill(NoiseType type, float* out, size_t n) {
+  if (type != buffered_type_) {
+    buffered_ = 0;
+    buffered_type_ = type;
+  }
+  size_t i = std::min(buffered_, n);
+  std::copy_n(buffer_ + (BATCH - buffered_), i, out);
+  buffered_ -= i;
+  for (; i + BATCH <= n; i += BATCH) NextBatch(out + i, type);
+  if (i < n) {
+    // Keep the rest of the batch for the next call
+    NextBatch(buffer_, type);
+    buffered_ = BATCH - (n - i);
+    std::copy(buffer_, buffer_ + (n - i), out + i);
+  }
+}
+
+void NoiseGenerator::Add(NoiseType type, float* out, size_t n, float scale) {
+  alignas(32) float batch[BATCH];
+  for (size_t i = 0; i < n; i += BATCH) {
+    const size_t count = std::min(BATCH, n - i);
+    Fill(type, batch, count);
+    for (size_t j = 0; j < count; ++j) out[i + j] += scale * batch[j];
+  }
+}
+
+float NoiseGenerator::Next(NoiseType type) {
+  if (buffered_ == 0 || type != buffered_type_) {
+    NextBatch(buffer_, type);
+    buffered_ = BATCH;
+    buffered_type_ = type;
+  }
+  return buffer_[BATCH - buffered_--];
+}
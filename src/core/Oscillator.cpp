@@ -0,0 +1,221 @@
+#include "Oscillator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Generator.hpp"
+
+namespace {
+
+// Chunk of the modulated path. As in Generator.hpp, fixed-size loops are
+// what GCC at -O2 vectorizes; modulation is staged through a local chunk,
+// since a loop reading one buffer and writing another is only vectorized
+// when they provably don't overlap.
+constexpr size_t CHUNK = 16;
+
+// Phases start + offsets[j], plus the phase modulation in radians, wrapped
+// to [0, 1) with truncation so the loop vectorizes; offsets and modulation
+// may be negative
+inline void WrapPhases(float start, const float* offsets,
+                       const float* phase_mod, float* out, size_t count) {
+  using GeneratorDetail::Truncate;
+  constexpr float RADIANS_TO_CYCLES = static_cast<float>(1.0 / (2.0 * M_PI));
+  float x[CHUNK];
+  for (size_t j = 0; j < count; ++j) x[j] = start + offsets[j];
+  if (phase_mod) {
+    for (size_t j = 0; j < count; ++j) x[j] += phase_mod[j] * RADIANS_TO_CYCLES;
+  }
+  for (size_t j = 0; j < count; ++j) {
+    const float f = x[j] - Truncate(x[j]) + 1.0f;  // (0, 2)
+    out[j] = f - Truncate(f);
+  }
+}
+
+// out[i] *= gain * (1 + modulation[i]), or gain without modulation
+void ApplyGain(float gain, const float* modulation, float* out, size_t n) {
+  size_t i = 0;
+  if (modulation) {
+    float gains[CHUNK];
+    for (; i + CHUNK <= n; i += CHUNK) {
+      for (size_t j = 0; j < CHUNK; ++j) {
+        gains[j] = gain * (1.0f + modulation[i + j]);
+      }
+      for (size_t j = 0; j < CHUNK; ++j) out[i + j] *= gains[j];
+    }
+    for (; i < n; ++i) out[i] *= gain * (1.0f + modulation[i]);
+  } else {
+    for (; i + CHUNK <= n; i += CHUNK) {
+      for (size_t j = 0; j < CHUNK; ++j) out[i + j] *= gain;
+    }
+    for (; i < n; ++i) out[i] *= gain;
+  }
+}
+
+// Replace phases in cycles by the unit shape
+template <WaveType TYPE>
+void ApplyShape(float* x, size_t n) {
+  size_t i = 0;
+  for (; i + CHUNK <= n; i += CHUNK) {
+    for (size_t j = 0; j < CHUNK; ++j) {
+      x[i + j] = WaveShape<TYPE>::Eval(x[i + j]);
+    }
+  }
+  for (; i < n; ++i) x[i] = WaveShape<TYPE>::Eval(x[i]);
+}
+
+using ShapeFn = void (*)(float* x, size_t n);
+
+ShapeFn SelectShape(WaveType type) {
+  switch (type) {
+    case WaveType::SINE:
+      break;
+    case WaveType::COSINE:
+      return ApplyShape<WaveType::COSINE>;
+    case WaveType::SQUARE:
+      return ApplyShape<WaveType::SQUARE>;
+    case WaveType::TRIANGLE:
+      return ApplyShape<WaveType::TRIANGLE>;
+    case WaveType::SAWTOOTH:
+      return ApplyShape<WaveType::SAWTOOTH>;
+    case WaveType::COMPOSITE:
+      break;
+  }
+  return ApplyShape<WaveType::SINE>;
+}
+
+}  // namespace
+
+void Oscillator::GenerateBlock(const WaveParams& params, double sample_rate,
+                               float* out, size_t n) {
+  Generate(params, sample_rate, phase_, noise_, out, n);
+}
+
+void Oscillator::Generate(const WaveParams& params, double sample_rate,
+                          double& phase, NoiseGenerator& noise, float* out,
+                          size_t n) {
+  if (n == 0) return;
+
+  // Not reduced to a fraction: composite partials with fractional ratios
+  // depend on the whole increment
+  const double increment = params.frequency / sample_rate;
+  const double offset = params.phase / (2.0 * M_PI);
+  if (params.wave_type == WaveType::COMPOSITE && params.composite) {
+    params.composite->Render(out, n, phase + offset, increment, params.amplitude);
+  } else {
+    const WaveKernels::KernelFn kernel =
+        SelectKernel(params.wave_type, params.generation);
+    kernel(out, n, phase + offset, increment, params.amplitude);
+  }
+
+  // Advance and wrap the accumulator
+  phase += increment * static_cast<double>(n);
+  phase -= std::floor(phase / PHASE_PERIOD) * PHASE_PERIOD;
+
+  // Add noise if enabled
+  if (params.noise > 0.0f) {
+    noise.Add(params.noise_type, out, n, params.noise * params.amplitude);
+  }
+}
+
+void Oscillator::GenerateModulated(const WaveParams& params,
+                                   double sample_rate, double& phase,
+                                   NoiseGenerator& noise,
+                                   const ModulationInput& modulation,
+                                   float* out, size_t n) {
+  if (n == 0) return;
+
+  const double offset = params.phase / (2.0 * M_PI);
+  if (params.wave_type == WaveType::COMPOSITE && params.composite &&
+      !modulation.frequency && !modulation.phase) {
+    const double increment = params.frequency / sample_rate;
+    params.composite->Render(out, n, phase + offset, increment, 1.0f);
+    phase += increment * static_cast<double>(n);
+  } else if (params.wave_type == WaveType::COMPOSITE && params.composite) {
+    // The partials are re-anchored every chunk at the modulated phase of
+    // its first sample and rotate at the mean increment up to its last
+    // sample, so FM and PM are followed piecewise-linearly per chunk.
+    constexpr double RADIANS_TO_CYCLES = 1.0 / (2.0 * M_PI);
+    const double increment = params.frequency / sample_rate;
+    for (size_t i = 0; i < n; i += CHUNK) {
+      const size_t count = std::min(CHUNK, n - i);
+      double advance = increment * static_cast<double>(count);
+      double span = increment * static_cast<double>(count - 1);
+      if (modulation.frequency) {
+        advance = 0.0;
+        for (size_t j = 0; j < count; ++j) {
+          if (j + 1 == count) span = advance;
+          advance += increment * (1.0 + modulation.frequency[i + j]);
+        }
+      }
+      double start = phase + offset;
+      if (modulation.phase) {
+        const float first = modulation.phase[i];
+        start += first * RADIANS_TO_CYCLES;
+        span += (modulation.phase[i + count - 1] - first) * RADIANS_TO_CYCLES;
+      }
+      const double chunk_increment =
+          count > 1 ? span / static_cast<double>(count - 1) : advance;
+      params.composite->Render(out + i, count, start, chunk_increment, 1.0f);
+      phase += advance;
+    }
+  } else {
+    // The phase is anchored in double at every chunk and offset in float
+    // within it. Only the prefix sum of a modulated increment is serial.
+    const double increment = params.frequency / sample_rate;
+    const float step = static_cast<float>(increment);
+    float offsets[CHUNK];
+    for (size_t j = 0; j < CHUNK; ++j) {
+      offsets[j] = step * static_cast<float>(j);
+    }
+    for (size_t i = 0; i < n; i += CHUNK) {
+      const size_t count = std::min(CHUNK, n - i);
+      double start = phase + offset;
+      start -= std::floor(start);
+      if (modulation.frequency) {
+        float sum = 0.0f;
+        for (size_t j = 0; j < count; ++j) {
+          offsets[j] = sum;
+          sum += step * (1.0f + modulation.frequency[i + j]);
+        }
+        phase += sum;
+      } else {
+        phase += increment * static_cast<double>(count);
+      }
+      const float anchor = static_cast<float>(start);
+      const float* phase_mod =
+          modulation.phase ? modulation.phase + i : nullptr;
+      // A constant count for full chunks, so the inlined loops vectorize
+      if (count == CHUNK) {
+        WrapPhases(anchor, offsets, phase_mod, out + i, CHUNK);
+      } else {
+        WrapPhases(anchor, offsets, phase_mod, out + i, count);
+      }
+    }
+    SelectShape(params.wave_type)(out, n);
+  }
+  phase -= std::floor(phase / PHASE_PERIOD) * PHASE_PERIOD;
+
+  ApplyGain(params.amplitude, modulation.amplitude, out, n);
+  if (params.noise > 0.0f) {
+    noise.Add(params.noise_type, out, n, params.noise * params.amplitude);
+  }
+}
+
+WaveKernels::KernelFn Oscillator::SelectKernel(WaveType type,
+                                               GenerationMode mode) {
+  switch (mode) {
+    case GenerationMode::NAIVE:
+      break;
+    case GenerationMode::POLYBLEP:
+      return WaveKernels::GetBandLimited(type);
+    case GenerationMode::WAVETABLE_LINEAR:
+      return Wavetable::GetKernel(type, false);
+    case GenerationMode::WAVETABLE_CUBIC:
+      return Wavetable::GetKernel(type, true);
+  }
+  return WaveKernels::Get(type);
+}
+
+void Oscillator::Reset(double phase) {
+  phase_ = phase - std::floor(phase / PHASE_PERIOD) * PHASE_PERIOD;
+}
@@ -0,0 +1,200 @@
+#include "OscillatorBank.hpp"
+
+#include <algorithm>
+
+#include "ThreadPool.hpp"
+#include "Trace.hpp"
+
+WaveParams OscillatorBank::DefaultChannel(size_t index) {
+  constexpr int WAVE_TYPE_COUNT = 5;  // The fixed shapes
+  WaveParams params;
+  params.wave_type = static_cast<WaveType>(index % WAVE_TYPE_COUNT);
+  params.frequency = 1.f + 0.25f * static_cast<float>(index);
+  params.amplitude = 1.f;
+  return params;
+}
+
+void OscillatorBank::Resize(size_t count) {
+  count = std::min(count, MAX_CHANNELS);
+  const size_t old_count = GetChannelCount();
+  wave_types_.resize(count);
+  frequencies_.resize(count);
+  amplitudes_.resize(count);
+  phases_.resize(count);
+  noises_.resize(count);
+  noise_types_.resize(count);
+  generation_modes_.resize(count);
+  composites_.resize(count);
+  accumulators_.resize(count, 0.0);
+  noise_generators_.resize(count);
+  for (size_t c = old_count; c < count; ++c) {
+    SetChannel(c, DefaultChannel(c));
+    noise_generators_[c].Seed(seed_, c);
+  }
+}
+
+WaveParams OscillatorBank::GetChannel(size_t channel) const {
+  return {wave_types_[channel], frequencies_[channel], amplitudes_[channel],
+          phases_[channel], noises_[channel], noise_types_[channel],
+          generation_modes_[channel], composites_[channel]};
+}
+
+void OscillatorBank::SetChannel(size_t channel, const WaveParams& params) {
+  wave_types_[channel] = params.wave_type;
+  frequencies_[channel] = params.frequency;
+  amplitudes_[channel] = params.amplitude;
+  phases_[channel] = params.phase;
+  noises_[channel] = params.noise;
+  noise_types_[channel] = params.noise_type;
+  generation_modes_[channel] = params.generation;
+  composites_[channel] = params.composite;
+}
+
+void OscillatorBank::ResetPhases() {
+  std::fill(accumulators_.begin(), accumulators_.end(), 0.0);
+  previous_.clear();
+}
+
+void OscillatorBank::SetSeed(uint64_t seed) {
+  seed_ = seed;
+  for (size_t c = 0; c < noise_generators_.size(); ++c) {
+    noise_generators_[c].Seed(seed_, c);
+  }
+}
+
+void OscillatorBank::GenerateChannel(size_t channel, double sample_rate,
+                                     float* out, size_t n) {
+  Oscillator::Generate(GetChannel(channel), sample_rate, accumulators_[channel],
+                       noise_generators_[channel], out, n);
+}
+
+void OscillatorBank::GenerateBlock(double sample_rate, float* out, size_t n,
+                                   size_t stride, ThreadPool* pool) {
+  TRACE_SCOPE("OscillatorBank::GenerateBlock");
+  auto parallel_for = [pool](size_t count, size_t grain,
+                             const ThreadPool::RangeFn& fn) {
+    if (pool) {
+      pool->ParallelFor(count, grain, fn);
+    } else {
+      fn(0, count);
+    }
+  };
+  const size_t grain = TaskGrain(n);
+
+  PlanModulation();
+  if (active_routes_.empty()) {
+    parallel_for(GetChannelCount(), grain, [&](size_t begin, size_t end) {
+      for (size_t c = begin; c < end; ++c) {
+        GenerateChannel(c, sample_rate, out + c * stride, n);
+      }
+    });
+    return;
+  }
+
+  // Stage one: the channels nothing modulates, which are the sources of
+  // stage two
+  parallel_for(free_channels_.size(), grain, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const size_t c = free_channels_[i];
+      GenerateChannel(c, sample_rate, out + c * stride, n);
+    }
+  });
+  // Stage two: every modulated channel, reading stage one's output and the
+  // previous block of modulated sources
+  parallel_for(destinations_.size() - 1, grain, [&](size_t begin, size_t end) {
+    for (size_t d = begin; d < end; ++d) {
+      GenerateModulated(destinations_[d], destinations_[d + 1], sample_rate,
+                        out, n, stride);
+    }
+  });
+  for (size_t c : delayed_sources_) {
+    previous_[c].assign(out + c * stride, out + c * stride + n);
+  }
+}
+
+void OscillatorBank::PlanModulation() {
+  const size_t count = GetChannelCount();
+  active_routes_.clear();
+  for (const ModRoute& route : modulation_.GetRoutes()) {
+    if (route.source < count && route.destination < count) {
+      active_routes_.push_back(route);
+    }
+  }
+  if (active_routes_.empty()) return;
+  std::stable_sort(active_routes_.begin(), active_routes_.end(),
+                   [](const ModRoute& a, const ModRoute& b) {
+                     return a.destination < b.destination;
+                   });
+
+  modulated_.assign(count, 0);
+  destinations_.clear();
+  for (size_t r = 0; r < active_routes_.size(); ++r) {
+    const uint32_t destination = active_routes_[r].destination;
+    if (!modulated_[destination]) {
+      modulated_[destination] = 1;
+      destinations_.push_back(r);
+    }
+  }
+  destinations_.push_back(active_routes_.size());
+
+  free_channels_.clear();
+  for (size_t c = 0; c < count; ++c) {
+    if (!modulated_[c]) free_channels_.push_back(c);
+  }
+  delayed_sources_.clear();
+  for (const ModRoute& route : active_routes_) {
+    if (modulated_[route.source]) delayed_sources_.push_back(route.source);
+  }
+  std::sort(delayed_sources_.begin(), delayed_sources_.end());
+  delayed_sources_.erase(
+      std::unique(delayed_sources_.begin(), delayed_sources_.end()),
+      delayed_sources_.end());
+  previous_.resize(count);
+}
+
+void OscillatorBank::GenerateModulated(size_t first, size_t last,
+                                       double sample_rate, float* out,
+                                       size_t n, size_t stride) {
+  // Summed modulation per target and the held copy of a short previous
+  // block, per worker and reused across calls
+  thread_local std::vector<float> sums;
+  thread_local std::vector<float> held;
+  constexpr size_t TARGET_COUNT = 3;
+  sums.resize(TARGET_COUNT * n);
+  float* targets[TARGET_COUNT] = {nullptr, nullptr, nullptr};
+
+  for (size_t r = first; r < last; ++r) {
+    const ModRoute& route = active_routes_[r];
+    const float* source = out + route.source * stride;
+    if (modulated_[route.source]) {
+      // Previous block, held on its last sample if it was shorter
+      const std::vector<float>& previous = previous_[route.source];
+      source = previous.data();
+      if (previous.size() < n) {
+        held.assign(previous.begin(), previous.end());
+        held.resize(n, previous.empty() ? 0.f : previous.back());
+        source = held.data();
+      }
+    }
+    const size_t target = static_cast<size_t>(route.target);
+    if (!targets[target]) {
+      targets[target] = sums.data() + target * n;
+      std::fill(targets[target], targets[target] + n, 0.f);
+    }
+    ModulationMatrix::Accumulate(source, route.depth, targets[target], n);
+  }
+
+  const size_t channel = active_routes_[first].destination;
+  ModulationInput modulation;
+  modulation.frequency = targets[static_cast<size_t>(ModTarget::FREQUENCY)];
+  modulation.amplitude = targets[static_cast<size_t>(ModTarget::AMPLITUDE)];
+  modulation.phase = targets[static_cast<size_t>(ModTarget::PHASE)];
+  Oscillator::GenerateModulated(GetChannel(channel), sample_rate,
+                                accumulators_[channel],
+                                noise_generators_[channel], modulation,
+                                out + channel * stride, n);
+}
+
+size_t OscillatorBank::TaskGrain(size_t samples_per_channel) {
+  return std::max<size_t>(1, TASK_SAMPLES / std::max<size_t>(samples_per_channel, 1));
+}
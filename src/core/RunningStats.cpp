@@ -0,0 +1,78 @@
+#include "RunningStats.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void RunningStats::CompensatedSum::Add(double value) {
+  const double total = sum + value;
+  if (std::abs(sum) >= std::abs(value)) {
+    compensation += (sum - total) + value;
+  } else {
+    compensation += (value - total) + sum;
+  }
+  sum = total;
+}
+
+void RunningStats::Reset() {
+  min_.clear();
+  max_.clear();
+  pushed_ = 0;
+  popped_ = 0;
+  count_ = 0;
+  shift_ = 0.0;
+  sum_ = {};
+  sum_squares_ = {};
+}
+
+void RunningStats::Push(float value) {
+  if (count_ == 0) {
+    // Re-anchor the sums whenever the window runs empty
+    shift_ = value;
+    sum_ = {};
+    sum_squares_ = {};
+  }
+
+  const uint64_t index = pushed_++;
+  while (!min_.empty() && min_.back().value >= value) min_.pop_back();
+  min_.push_back({index, value});
+  while (!max_.empty() && max_.back().value <= value) max_.pop_back();
+  max_.push_back({index, value});
+
+  const double d = value - shift_;
+  sum_.Add(d);
+  sum_squares_.Add(d * d);
+  ++count_;
+}
+
+void RunningStats::Pop(float value) {
+  if (count_ == 0) return;
+
+  const uint64_t index = popped_++;
+  if (!min_.empty() && min_.front().index == index) min_.pop_front();
+  if (!max_.empty() && max_.front().index == index) max_.pop_front();
+
+  const double d = value - shift_;
+  sum_.Add(-d);
+  sum_squares_.Add(-d * d);
+  --count_;
+}
+
+double RunningStats::GetMean() const {
+  if (count_ == 0) return 0.0;
+  return shift_ + sum_.Get() / count_;
+}
+
+double RunningStats::GetVariance() const {
+  if (count_ == 0) return 0.0;
+  const double mean = sum_.Get() / count_;
+  return std::max(sum_squares_.Get() / count_ - mean * mean, 0.0);
+}
+
+double RunningStats::GetStdDev() const { return std::sqrt(GetVariance()); }
+
+double RunningStats::GetRms() const {
+  if (count_ == 0) return 0.0;
+  // E[x^2] = Var + E[x]^2
+  const double mean = GetMean();
+  return std::sqrt(GetVariance() + mean * mean);
+}
@@ -0,0 +1,151 @@
+#include "SampleRecorder.hpp"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iterator>
+
+#include "Trace.hpp"
+
+SampleRecorder::SampleRecorder() : queue_(QUEUE_CAPACITY) {}
+
+bool SampleRecorder::Start(const std::string& path, double sample_rate) {
+  if (IsRecording()) return false;
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) return false;
+  // Output is already written in large blocks
+  std::setvbuf(file_, nullptr, _IONBF, 0);
+
+  path_ = path;
+  sample_rate_ = sample_rate;
+  next_index_ = 0;
+  pending_ = 0;
+  last_flush_ = std::chrono::steady_clock::now();
+  written_ = 0;
+  bytes_ = 0;
+  dropped_ = 0;
+  error_ = 0;
+  block_.clear();
+  block_.reserve(WRITE_BLOCK + 4096);
+  FormatHeader(block_);
+
+#ifndef __EMSCRIPTEN__
+  stop_ = false;
+  thread_ = std::thread(&SampleRecorder::ThreadMain, this);
+#endif
+  return true;
+}
+
+bool SampleRecorder::Stop() {
+  if (!IsRecording()) return !HasFailed();
+#ifndef __EMSCRIPTEN__
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+#endif
+  DrainQueue();
+  Flush();
+  // Finish even after a failure, so a header can describe what was written
+  if (!Finish(file_) || std::ferror(file_)) Fail();
+  if (std::fclose(file_) != 0) Fail();
+  file_ = nullptr;
+  return !HasFailed();
+}
+
+void SampleRecorder::OnSamples(const float* values, size_t count,
+                               uint64_t first_index) {
+  (void)first_index;
+  if (!IsRecording() || HasFailed()) return;
+  size_t accepted = queue_.Push(values, count);
+  if (accepted < count) dropped_ += count - accepted;
+#ifdef __EMSCRIPTEN__
+  DrainQueue();
+  FlushIfDue();
+#endif
+}
+
+void SampleRecorder::ThreadMain() {
+#ifndef __EMSCRIPTEN__
+  Trace::SetThreadName("Recorder");
+  std::unique_lock<std::mutex> lock(wake_mutex_);
+  while (!stop_) {
+    lock.unlock();
+    DrainQueue();
+    FlushIfDue();
+    lock.lock();
+    // The producer never signals, it only appends; poll at a rate that
+    // keeps the queue far from full even at the maximum sample rate
+    wake_.wait_for(lock, std::chrono::milliseconds(10),
+                   [this] { return stop_.load(); });
+  }
+#endif
+}
+
+void SampleRecorder::DrainQueue() {
+  TRACE_SCOPE("SampleRecorder::Format");
+  queue_.Consume(queue_.Capacity(), [this](const float* values, size_t n) {
+    // After a failed write nothing more reaches the file
+    if (HasFailed()) return;
+    // Format in slices so the block never grows far beyond WRITE_BLOCK
+    constexpr size_t SLICE = 4096;
+    for (size_t offset = 0; offset < n; offset += SLICE) {
+      const size_t count = std::min(SLICE, n - offset);
+      FormatSamples(values + offset, count, next_index_, block_);
+      next_index_ += count;
+      pending_ += count;
+      if (block_.size() >= WRITE_BLOCK) Flush();
+    }
+  });
+}
+
+void SampleRecorder::Flush() {
+  if (block_.empty()) return;
+  TRACE_SCOPE("SampleRecorder::Write");
+  const size_t written = std::fwrite(block_.data(), 1, block_.size(), file_);
+  bytes_ += written;
+  if (written == block_.size()) {
+    written_ += pending_;
+  } else {
+    Fail();
+  }
+  pending_ = 0;
+  block_.clear();
+  last_flush_ = std::chrono::steady_clock::now();
+}
+
+void SampleRecorder::FlushIfDue() {
+  if (block_.empty() || HasFailed()) return;
+  const auto elapsed = std::chrono::steady_clock::now() - last_flush_;
+  if (elapsed >= std::chrono::milliseconds(FLUSH_INTERVAL_MS)) Flush();
+}
+
+void SampleRecorder::Fail() {
+  int expected = 0;
+  error_.compare_exchange_strong(expected, errno != 0 ? errno : EIO);
+}
+
+void FormatCsvRows(const float* values, size_t count, uint64_t index,
+                   double sample_rate, std::vector<char>& out) {
+  const double period = 1.0 / sample_rate;
+  auto it = std::back_inserter(out);
+  for (size_t i = 0; i < count; ++i) {
+    // Shortest round-trip representation of each number
+    it = fmt::format_to(it, "{},{},{}\n", index + i, (index + i) * period,
+                        values[i]);
+  }
+}
+
+void CsvRecorder::FormatHeader(std::vector<char>& out) {
+  out.insert(out.end(), CSV_HEADER, CSV_HEADER + std::strlen(CSV_HEADER));
+}
+
+void CsvRecorder::FormatSamples(const float* values, size_t count,
+                                uint64_t index, std::vector<char>& out) {
+  FormatCsvRows(values, count, index, GetSampleRate(), out);
+}
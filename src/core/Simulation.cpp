@@ -0,0 +1,179 @@
+#include "Simulation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "CoreLogic.hpp"
+#include "Trace.hpp"
+
+namespace {
+
+constexpr auto TICK = std::chrono::milliseconds(1);
+constexpr size_t BLOCK_SIZE = 4096;
+// Never catch up more than 100 ms of samples in one tick
+constexpr double MAX_BACKLOG_SECONDS = 0.1;
+
+}  // namespace
+
+// SampleClock
+
+void SampleClock::Start(double sample_rate, Clock::time_point now) {
+  rate_ = sample_rate;
+  start_ = now;
+  emitted_ = 0;
+}
+
+size_t SampleClock::Advance(Clock::time_point now, size_t max_backlog) {
+  const double elapsed = std::chrono::duration<double>(now - start_).count();
+  const uint64_t due_total = static_cast<uint64_t>(elapsed * rate_);
+  if (due_total <= emitted_) return 0;
+
+  uint64_t due = due_total - emitted_;
+  if (due > max_backlog) {
+    skipped_ += due - max_backlog;
+    due = max_backlog;
+  }
+  emitted_ = due_total;
+  return static_cast<size_t>(due);
+}
+
+// Simulation
+
+Simulation::Simulation(size_t queue_capacity)
+    : samples_(queue_capacity), settings_(16) {}
+
+Simulation::~Simulation() { Stop(); }
+
+void Simulation::Start(const WaveParams& params, double sample_rate) {
+  if (running_.load()) return;
+  wanted_.params = params;
+  wanted_.sample_rate =
+      std::clamp(sample_rate, MIN_SAMPLE_RATE, MAX_SAMPLE_RATE);
+  published_ = wanted_;
+  rate_window_start_ = SampleClock::Clock::now();
+  running_.store(true);
+  thread_ = std::thread(&Simulation::ThreadMain, this, published_);
+}
+
+void Simulation::Stop() {
+  if (!running_.load()) return;
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    running_.store(false);
+  }
+  wake_.notify_all();
+  if (thread_.joinable()) thread_.join();
+}
+
+void Simulation::SetParameters(const WaveParams& params, double sample_rate) {
+  wanted_.params = params;
+  wanted_.sample_rate =
+      std::clamp(sample_rate, MIN_SAMPLE_RATE, MAX_SAMPLE_RATE);
+  Publish();
+}
+
+void Simulation::Reseed(uint64_t seed) {
+  wanted_.seed = seed;
+  ++wanted_.reseeds;
+  Publish();
+}
+
+void Simulation::Publish() {
+  if (wanted_ == published_) return;
+  // If the queue is full the change is retried on the next call
+  if (settings_.Push(wanted_)) published_ = wanted_;
+}
+
+void Simulation::SetPaused(bool paused) {
+  if (paused_.load() == paused) return;
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    paused_.store(paused);
+  }
+  wake_.notify_all();
+}
+
+size_t Simulation::Drain(CoreLogic& core) {
+  TRACE_SCOPE("Simulation::Drain");
+  size_t drained = samples_.Consume(
+      samples_.Capacity(),
+      [&core](const float* values, size_t n) { core.PushSamples(values, n); });
+
+  rate_window_samples_ += drained;
+  auto now = SampleClock::Clock::now();
+  double window = std::chrono::duration<double>(now - rate_window_start_).count();
+  if (window >= 0.5) {
+    measured_rate_ = rate_window_samples_ / window;
+    rate_window_samples_ = 0;
+    rate_window_start_ = now;
+  }
+  return drained;
+}
+
+void Simulation::ThreadMain(Settings settings) {
+  Trace::SetThreadName("Simulation");
+  Oscillator oscillator(settings.seed);
+  SampleClock clock;
+  std::vector<float> block(BLOCK_SIZE);
+  uint64_t skipped = 0;
+
+  auto now = SampleClock::Clock::now();
+  clock.Start(settings.sample_rate, now);
+  auto next_tick = now;
+
+  while (running_.load(std::memory_order_relaxed)) {
+    if (paused_.load(std::memory_order_relaxed)) {
+      std::unique_lock<std::mutex> lock(wake_mutex_);
+      wake_.wait(lock, [this] { return !paused_.load() || !running_.load(); });
+      // Resume without generating the samples of the paused interval
+      now = SampleClock::Clock::now();
+      clock.Start(settings.sample_rate, now);
+      next_tick = now;
+      continue;
+    }
+
+    // Apply the latest parameters; only the newest snapshot matters
+    Settings latest;
+    bool changed = false;
+    while (settings_.Pop(latest)) changed = true;
+    now = SampleClock::Clock::now();
+    if (changed) {
+      if (latest.sample_rate != settings.sample_rate) {
+        clock.Start(latest.sample_rate, now);
+      }
+      if (latest.reseeds != settings.reseeds) oscillator.Seed(latest.seed);
+      settings = latest;
+    }
+
+    const size_t max_backlog = std::max<size_t>(
+        BLOCK_SIZE,
+        static_cast<size_t>(settings.sample_rate * MAX_BACKLOG_SECONDS));
+    size_t due = clock.Advance(now, max_backlog);
+    if (due > 0) {
+      TRACE_SCOPE("Simulation::Generate");
+      while (due > 0) {
+        const size_t n = std::min(due, BLOCK_SIZE);
+        oscillator.GenerateBlock(settings.params, settings.sample_rate,
+                                 block.data(), n);
+        const size_t pushed = samples_.Push(block.data(), n);
+        generated_.fetch_add(n, std::memory_order_relaxed);
+        if (pushed < n) {
+          dropped_.fetch_add(n - pushed, std::memory_order_relaxed);
+        }
+        due -= n;
+      }
+    }
+    if (clock.GetSkipped() != skipped) {
+      dropped_.fetch_add(clock.GetSkipped() - skipped,
+                         std::memory_order_relaxed);
+      skipped = clock.GetSkipped();
+    }
+
+    // Fixed timestep; if we overran, restart the schedule from now
+    next_tick += TICK;
+    now = SampleClock::Clock::now();
+    if (next_tick < now) next_tick = now;
+    std::this_thread::sleep_until(next_tick);
+  }
+}
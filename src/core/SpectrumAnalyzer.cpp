@@ -0,0 +1,155 @@
+#include "SpectrumAnalyzer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+
+#include "Trace.hpp"
+
+namespace {
+
+// Periodic (DFT-even) windows, so they tile exactly over the transform
+void FillWindow(FftWindow type, float* out, size_t length) {
+  constexpr double TWO_PI = 2.0 * std::numbers::pi;
+  for (size_t i = 0; i < length; ++i) {
+    const double x = TWO_PI * i / length;
+    double w = 1.0;
+    switch (type) {
+      case FftWindow::RECTANGULAR:
+        w = 1.0;
+        break;
+      case FftWindow::HANN:
+        w = 0.5 - 0.5 * std::cos(x);
+        break;
+      case FftWindow::BLACKMAN_HARRIS:
+        w = 0.35875 - 0.48829 * std::cos(x) + 0.14128 * std::cos(2 * x) -
+            0.01168 * std::cos(3 * x);
+        break;
+    }
+    out[i] = static_cast<float>(w);
+  }
+}
+
+}  // namespace
+
+SpectrumAnalyzer::SpectrumAnalyzer() {
+#ifndef __EMSCRIPTEN__
+  thread_ = std::thread(&SpectrumAnalyzer::ThreadMain, this);
+#endif
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer() {
+#ifndef __EMSCRIPTEN__
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+#endif
+}
+
+bool SpectrumAnalyzer::Submit(const SampleView& history, size_t size,
+                              FftWindow window, double sample_rate) {
+  size = std::clamp(std::bit_ceil(size), MIN_SIZE, MAX_SIZE);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (has_request_ || busy_) return false;
+
+    const size_t count = std::min(size, history.size());
+    const size_t skip = history.size() - count;
+    pending_.samples.resize(count);
+    for (size_t i = 0; i < count; ++i) pending_.samples[i] = history[skip + i];
+    pending_.size = size;
+    pending_.window = window;
+    pending_.sample_rate = sample_rate;
+    pending_.version = history.version;
+    has_request_ = true;
+  }
+
+#ifdef __EMSCRIPTEN__
+  std::swap(active_, pending_);
+  has_request_ = false;
+  Compute(active_, latest_);
+  has_result_ = true;
+#else
+  wake_.notify_one();
+#endif
+  return true;
+}
+
+bool SpectrumAnalyzer::Fetch(SpectrumResult& out) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!has_result_) return false;
+  std::swap(out, latest_);
+  has_result_ = false;
+  return true;
+}
+
+void SpectrumAnalyzer::ThreadMain() {
+  Trace::SetThreadName("Spectrum");
+  SpectrumResult result;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    wake_.wait(lock, [this] { return stop_ || has_request_; });
+    if (stop_) return;
+    std::swap(active_, pending_);
+    has_request_ = false;
+    busy_ = true;
+
+    lock.unlock();
+    Compute(active_, result);
+    lock.lock();
+
+    std::swap(latest_, result);
+    has_result_ = true;
+    busy_ = false;
+  }
+}
+
+void SpectrumAnalyzer::Compute(const Request& request, SpectrumResult& result) {
+  TRACE_SCOPE("SpectrumAnalyzer::Compute");
+  const auto start = std::chrono::steady_clock::now();
+  const size_t size = request.size;
+  const size_t length = request.samples.size();
+
+  fft_.Resize(size);
+  if (window_type_ != request.window || window_length_ != length) {
+    window_.resize(length);
+    FillWindow(request.window, window_.data(), length);
+    double sum = 0.0;
+    for (float w : window_) sum += w;
+    window_gain_ = sum > 0.0 ? static_cast<float>(sum) : 1.f;
+    window_type_ = request.window;
+    window_length_ = length;
+  }
+
+  // Windowed samples followed by zero padding
+  input_.assign(size, 0.f);
+  for (size_t i = 0; i < length; ++i) {
+    input_[i] = request.samples[i] * window_[i];
+  }
+  bins_.resize(size / 2 + 1);
+  fft_.Forward(input_.data(), bins_.data());
+
+  // Scale so a unit sine reads 0 dB: one-sided spectrum, corrected for the
+  // window's coherent gain
+  const size_t bin_count = bins_.size();
+  result.magnitude_db.resize(bin_count);
+  for (size_t k = 0; k < bin_count; ++k) {
+    const float scale = (k == 0 || k == bin_count - 1 ? 1.f : 2.f) / window_gain_;
+    const float magnitude = std::abs(bins_[k]) * scale;
+    result.magnitude_db[k] =
+        magnitude > 0.f ? std::max(20.f * std::log10(magnitude), FLOOR_DB)
+                        : FLOOR_DB;
+  }
+
+  result.size = size;
+  result.sample_rate = request.sample_rate;
+  result.version = request.version;
+  result.compute_ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+}
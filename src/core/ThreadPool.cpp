@@ -0,0 +1,118 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "Trace.hpp"
+
+size_t ThreadPool::DefaultWorkerCount() {
+#ifdef __EMSCRIPTEN__
+  return 0;
+#else
+  const unsigned hardware = std::thread::hardware_concurrency();
+  return hardware > 1 ? hardware - 1 : 0;
+#endif
+}
+
+ThreadPool::ThreadPool(size_t worker_count) {
+#ifdef __EMSCRIPTEN__
+  worker_count = 0;
+#endif
+  for (size_t i = 0; i <= worker_count; ++i) {
+    deques_.push_back(std::make_unique<TaskDeque>());
+  }
+  for (size_t i = 0; i < worker_count; ++i) {
+    threads_.emplace_back(&ThreadPool::WorkerMain, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& thread : threads_) thread.join();
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t grain, const RangeFn& fn) {
+  if (count == 0) return;
+  grain = std::max<size_t>(grain, 1);
+  if (threads_.empty() || count <= grain) {
+    fn(0, count);
+    return;
+  }
+
+  const size_t task_count = (count + grain - 1) / grain;
+  std::atomic<size_t> remaining{task_count};
+  // Counted before publishing: a worker that is already awake may pop a
+  // task and decrement as soon as it is pushed, which must not wrap the
+  // counter
+  {
+    std::lock_guard<std::mutex> lock(wake_mutex_);
+    queued_.fetch_add(task_count);
+  }
+  for (size_t t = 0; t < task_count; ++t) {
+    const size_t begin = t * grain;
+    Task task{&fn, begin, std::min(begin + grain, count), &remaining};
+    TaskDeque& deque = *deques_[t % deques_.size()];
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    deque.tasks.push_back(task);
+  }
+  wake_.notify_all();
+
+  // Work along, then wait for the tasks still running elsewhere
+  const size_t self = deques_.size() - 1;
+  Task task;
+  while (remaining.load(std::memory_order_acquire) > 0) {
+    if (PopLocal(self, task) || Steal(self, task)) {
+      Execute(task);
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void ThreadPool::WorkerMain(size_t index) {
+  Trace::SetThreadName(("Worker " + std::to_string(index)).c_str());
+  Task task;
+  while (true) {
+    if (PopLocal(index, task) || Steal(index, task)) {
+      Execute(task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_.wait(lock, [this] { return stopping_ || queued_.load() > 0; });
+    if (stopping_) return;
+  }
+}
+
+bool ThreadPool::PopLocal(size_t index, Task& task) {
+  TaskDeque& deque = *deques_[index];
+  std::lock_guard<std::mutex> lock(deque.mutex);
+  if (deque.tasks.empty()) return false;
+  task = deque.tasks.back();
+  deque.tasks.pop_back();
+  queued_.fetch_sub(1);
+  return true;
+}
+
+bool ThreadPool::Steal(size_t thief, Task& task) {
+  // Start at the neighbour so thieves spread over the victims
+  for (size_t i = 1; i < deques_.size(); ++i) {
+    TaskDeque& deque = *deques_[(thief + i) % deques_.size()];
+    std::lock_guard<std::mutex> lock(deque.mutex);
+    if (deque.tasks.empty()) continue;
+    task = deque.tasks.front();
+    deque.tasks.pop_front();
+    queued_.fetch_sub(1);
+    stolen_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::Execute(const Task& task) {
+  (*task.fn)(task.begin, task.end);
+  task.remaining->fetch_sub(1, std::memory_order_release);
+}
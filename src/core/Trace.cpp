@@ -0,0 +1,189 @@
+#include "Trace.hpp"
+
+#include <fmt/format.h>
+
+#include <cstdio>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Trace {
+namespace {
+
+struct Event {
+  const char* name;
+  int64_t start_ns;  // Since the trace epoch
+  int64_t duration_ns;
+  uint32_t thread;
+};
+
+// Written by one thread at a time; readers see events [0, count)
+struct ThreadBuffer {
+  std::unique_ptr<Event[]> events;
+  std::atomic<size_t> count{0};
+  std::atomic<uint32_t> generation{0};
+  bool in_use = false;  // Guarded by Registry::mutex
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  std::map<uint32_t, std::string> thread_names;
+  std::atomic<uint32_t> generation{1};
+  std::atomic<uint32_t> next_thread{1};
+  std::atomic<uint64_t> dropped{0};
+  const Clock::time_point epoch = Clock::now();
+};
+
+Registry& GetRegistry() {
+  static Registry registry;
+  return registry;
+}
+
+// Binds a buffer to the current thread and returns it to the pool when the
+// thread exits, so short-lived threads (e.g. recorders) reuse buffers
+struct ThreadSlot {
+  ThreadBuffer* buffer = nullptr;
+  uint32_t thread = 0;
+
+  ThreadSlot() {
+    Registry& registry = GetRegistry();
+    thread = registry.next_thread++;
+  }
+  ~ThreadSlot() {
+    if (!buffer) return;
+    std::lock_guard<std::mutex> lock(GetRegistry().mutex);
+    buffer->in_use = false;
+  }
+
+  ThreadBuffer& Acquire() {
+    if (buffer) return *buffer;
+    Registry& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (auto& candidate : registry.buffers) {
+      if (!candidate->in_use) {
+        buffer = candidate.get();
+        break;
+      }
+    }
+    if (!buffer) {
+      registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+      buffer = registry.buffers.back().get();
+      buffer->events = std::make_unique<Event[]>(BUFFER_EVENTS);
+    }
+    buffer->in_use = true;
+    return *buffer;
+  }
+};
+
+ThreadSlot& GetThreadSlot() {
+  thread_local ThreadSlot slot;
+  return slot;
+}
+
+int64_t ToNs(Clock::time_point t) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             t - GetRegistry().epoch)
+      .count();
+}
+
+}  // namespace
+
+void detail::Record(const char* name, Clock::time_point start,
+                    Clock::time_point end) {
+  Registry& registry = GetRegistry();
+  ThreadSlot& slot = GetThreadSlot();
+  ThreadBuffer& buffer = slot.Acquire();
+
+  // A new trace was started since this buffer was last written
+  const uint32_t generation = registry.generation.load(std::memory_order_acquire);
+  if (buffer.generation.load(std::memory_order_relaxed) != generation) {
+    buffer.generation.store(generation, std::memory_order_relaxed);
+    buffer.count.store(0, std::memory_order_relaxed);
+  }
+
+  const size_t index = buffer.count.load(std::memory_order_relaxed);
+  if (index >= BUFFER_EVENTS) {
+    registry.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  buffer.events[index] = {name, ToNs(start), ToNs(end) - ToNs(start), slot.thread};
+  buffer.count.store(index + 1, std::memory_order_release);
+}
+
+void Start() {
+  Registry& registry = GetRegistry();
+  registry.generation.fetch_add(1, std::memory_order_acq_rel);
+  registry.dropped = 0;
+  detail::enabled.store(true, std::memory_order_relaxed);
+}
+
+void Stop() { detail::enabled.store(false, std::memory_order_relaxed); }
+
+void SetThreadName(const char* name) {
+  Registry& registry = GetRegistry();
+  const uint32_t thread = GetThreadSlot().thread;
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.thread_names[thread] = name;
+}
+
+uint64_t GetEventCount() {
+  Registry& registry = GetRegistry();
+  const uint32_t generation = registry.generation.load(std::memory_order_acquire);
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  uint64_t total = 0;
+  for (const auto& buffer : registry.buffers) {
+    if (buffer->generation == generation) {
+      total += buffer->count.load(std::memory_order_acquire);
+    }
+  }
+  return total;
+}
+
+uint64_t GetDroppedEvents() { return GetRegistry().dropped.load(); }
+
+bool WriteJson(const std::string& path) {
+  std::FILE* file = std::fopen(path.c_str(), "wb");
+  if (!file) return false;
+
+  Registry& registry = GetRegistry();
+  const uint32_t generation = registry.generation.load(std::memory_order_acquire);
+  std::vector<char> out;
+  auto it = std::back_inserter(out);
+  fmt::format_to(it, "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  bool first = true;
+  auto separator = [&first]() {
+    const char* s = first ? "" : ",\n";
+    first = false;
+    return s;
+  };
+
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  for (const auto& [thread, name] : registry.thread_names) {
+    fmt::format_to(it,
+                   "{}{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+                   "\"tid\":{},\"args\":{{\"name\":\"{}\"}}}}",
+                   separator(), thread, name);
+  }
+  for (const auto& buffer : registry.buffers) {
+    if (buffer->generation != generation) continue;
+    const size_t count = buffer->count.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; ++i) {
+      const Event& e = buffer->events[i];
+      // Chrome expects microseconds
+      fmt::format_to(it,
+                     "{}{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},"
+                     "\"ts\":{:.3f},\"dur\":{:.3f}}}",
+                     separator(), e.name, e.thread, e.start_ns / 1000.0,
+                     e.duration_ns / 1000.0);
+    }
+  }
+  fmt::format_to(it, "\n]}}\n");
+
+  const bool ok = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+  return std::fclose(file) == 0 && ok;
+}
+
+}  // namespace Trace
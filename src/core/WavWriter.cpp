@@ -0,0 +1,205 @@
+#include "WavWriter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "Trace.hpp"
+
+namespace {
+
+constexpr size_t BLOCK_FRAMES = 1 << 16;
+
+template <typename T>
+void Append(std::vector<char>& out, T value) {
+  // WAV is little-endian, as are all supported targets
+  const size_t offset = out.size();
+  out.resize(offset + sizeof(T));
+  std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+
+void AppendTag(std::vector<char>& out, const char (&tag)[5]) {
+  out.insert(out.end(), tag, tag + 4);
+}
+
+}  // namespace
+
+namespace Wav {
+
+size_t BytesPerSample(WavFormat format) {
+  switch (format) {
+    case WavFormat::PCM16:
+      return 2;
+    case WavFormat::PCM24:
+      return 3;
+    case WavFormat::FLOAT32:
+      return 4;
+  }
+  return 2;
+}
+
+void EncodeHeader(WavFormat format, uint32_t sample_rate, uint64_t frames,
+                  std::vector<char>& out) {
+  constexpr uint16_t FORMAT_PCM = 1;
+  constexpr uint16_t FORMAT_IEEE_FLOAT = 3;
+  const uint16_t bytes = static_cast<uint16_t>(BytesPerSample(format));
+  // RIFF sizes are 32-bit; longer recordings are clamped
+  const uint32_t data_size = static_cast<uint32_t>(
+      std::min<uint64_t>(frames * bytes, UINT32_MAX - HEADER_SIZE));
+
+  AppendTag(out, "RIFF");
+  Append<uint32_t>(out, data_size + HEADER_SIZE - 8);
+  AppendTag(out, "WAVE");
+  AppendTag(out, "fmt ");
+  Append<uint32_t>(out, 16);
+  Append<uint16_t>(out,
+                   format == WavFormat::FLOAT32 ? FORMAT_IEEE_FLOAT : FORMAT_PCM);
+  Append<uint16_t>(out, 1);  // Mono
+  Append<uint32_t>(out, sample_rate);
+  Append<uint32_t>(out, sample_rate * bytes);  // Byte rate
+  Append<uint16_t>(out, bytes);                // Block align
+  Append<uint16_t>(out, static_cast<uint16_t>(bytes * 8));
+  AppendTag(out, "data");
+  Append<uint32_t>(out, data_size);
+}
+
+void EncodeSamples(WavFormat format, const float* values, size_t n,
+                   float full_scale, std::vector<char>& out) {
+  const float gain = full_scale > 0.f ? 1.f / full_scale : 1.f;
+  const size_t offset = out.size();
+  out.resize(offset + n * BytesPerSample(format));
+  char* dst = out.data() + offset;
+
+  switch (format) {
+    case WavFormat::PCM16:
+      for (size_t i = 0; i < n; ++i) {
+        const float v = std::clamp(values[i] * gain, -1.f, 1.f);
+        const int16_t s = static_cast<int16_t>(std::lrint(v * 32767.f));
+        std::memcpy(dst + 2 * i, &s, 2);
+      }
+      break;
+    case WavFormat::PCM24:
+      for (size_t i = 0; i < n; ++i) {
+        const float v = std::clamp(values[i] * gain, -1.f, 1.f);
+        const int32_t s = static_cast<int32_t>(std::lrint(v * 8388607.f));
+        dst[3 * i] = static_cast<char>(s & 0xff);
+        dst[3 * i + 1] = static_cast<char>((s >> 8) & 0xff);
+        dst[3 * i + 2] = static_cast<char>((s >> 16) & 0xff);
+      }
+      break;
+    case WavFormat::FLOAT32:
+      for (size_t i = 0; i < n; ++i) {
+        const float v = values[i] * gain;
+        std::memcpy(dst + 4 * i, &v, 4);
+      }
+      break;
+  }
+}
+
+bool PatchHeader(std::FILE* file, WavFormat format, uint32_t sample_rate,
+                 uint64_t frames) {
+  std::vector<char> header;
+  EncodeHeader(format, sample_rate, frames, header);
+  if (std::fseek(file, 0, SEEK_SET) != 0) return false;
+  return std::fwrite(header.data(), 1, header.size(), file) == header.size();
+}
+
+}  // namespace Wav
+
+bool WavWriter::Open(const std::string& path, WavFormat format,
+                     uint32_t sample_rate, float full_scale) {
+  Close();
+  file_ = std::fopen(path.c_str(), "wb");
+  if (!file_) return false;
+  format_ = format;
+  sample_rate_ = sample_rate;
+  full_scale_ = full_scale;
+  frames_ = 0;
+
+  // Placeholder header, patched in Close()
+  block_.clear();
+  Wav::EncodeHeader(format_, sample_rate_, 0, block_);
+  failed_ =
+      std::fwrite(block_.data(), 1, block_.size(), file_) != block_.size();
+  return true;
+}
+
+bool WavWriter::Write(const float* values, size_t n) {
+  if (!file_ || failed_) return false;
+  block_.clear();
+  Wav::EncodeSamples(format_, values, n, full_scale_, block_);
+  const size_t written = std::fwrite(block_.data(), 1, block_.size(), file_);
+  frames_ += written / Wav::BytesPerSample(format_);
+  failed_ = written != block_.size();
+  return !failed_;
+}
+
+bool WavWriter::Close() {
+  if (!file_) return false;
+  bool ok = !failed_ && !std::ferror(file_);
+  ok = Wav::PatchHeader(file_, format_, sample_rate_, frames_) && ok;
+  ok = std::fclose(file_) == 0 && ok;
+  file_ = nullptr;
+  return ok;
+}
+
+bool RenderWavFile(const std::string& path, const WaveParams& params,
+                   uint32_t sample_rate, double duration, WavFormat format,
+                   WavRenderStats* stats, uint64_t seed,
+                   std::atomic<uint64_t>* progress) {
+  TRACE_SCOPE("RenderWavFile");
+  const auto start = std::chrono::steady_clock::now();
+  const float full_scale = std::max(params.Peak(), 1e-6f);
+
+  WavWriter writer;
+  if (!writer.Open(path, format, sample_rate, full_scale)) return false;
+
+  Oscillator oscillator(seed);
+  std::vector<float> block(BLOCK_FRAMES);
+  uint64_t remaining = static_cast<uint64_t>(std::llround(duration * sample_rate));
+  while (remaining > 0) {
+    const size_t n = static_cast<size_t>(std::min<uint64_t>(remaining, BLOCK_FRAMES));
+    oscillator.GenerateBlock(params, sample_rate, block.data(), n);
+    if (!writer.Write(block.data(), n)) break;
+    if (progress) progress->store(writer.GetFrames());
+    remaining -= n;
+  }
+  const uint64_t frames = writer.GetFrames();
+  const bool ok = writer.Close();
+
+  if (stats) {
+    stats->frames = frames;
+    stats->seconds = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start)
+                         .count();
+    stats->samples_per_second =
+        stats->seconds > 0.0 ? frames / stats->seconds : 0.0;
+  }
+  return ok;
+}
+
+uint32_t WavRecorder::GetIntegerRate() const {
+  return static_cast<uint32_t>(std::max(std::lround(GetSampleRate()), 1L));
+}
+
+void WavRecorder::FormatHeader(std::vector<char>& out) {
+  Wav::EncodeHeader(format_, GetIntegerRate(), 0, out);
+}
+
+void WavRecorder::FormatSamples(const float* values, size_t count,
+                                uint64_t index, std::vector<char>& out) {
+  (void)index;
+  Wav::EncodeSamples(format_, values, count, full_scale_, out);
+}
+
+bool WavRecorder::Finish(std::FILE* file) {
+  // Count the frames that reached the file, which after a failed write is
+  // fewer than were formatted
+  const uint64_t bytes = GetWrittenBytes();
+  const uint64_t frames =
+      bytes > Wav::HEADER_SIZE
+          ? (bytes - Wav::HEADER_SIZE) / Wav::BytesPerSample(format_)
+          : 0;
+  return Wav::PatchHeader(file, format_, GetIntegerRate(), frames);
+}
@@ -0,0 +1,382 @@
+#include "WaveKernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "WaveKernelsDetail.hpp"
+
+namespace {
+
+using WaveKernels::detail::SIN_C1;
+using WaveKernels::detail::SIN_C3;
+using WaveKernels::detail::SIN_C5;
+using WaveKernels::detail::SIN_C7;
+using WaveKernels::detail::SIN_C9;
+using WaveKernels::detail::SIN_C11;
+
+// Scalar shapes; f is the phase in cycles, in [0, 1]
+
+inline float SinCycles(float f) {
+  float x = f >= 0.5f ? f - 1.0f : f;  // [-0.5, 0.5)
+  float a = std::min(std::fabs(x), 0.5f - std::fabs(x));  // Quarter wave
+  float y = std::copysign(a, x);
+  float y2 = y * y;
+  float r = SIN_C9 + y2 * SIN_C11;
+  r = SIN_C7 + y2 * r;
+  r = SIN_C5 + y2 * r;
+  r = SIN_C3 + y2 * r;
+  r = SIN_C1 + y2 * r;
+  return y * r;
+}
+
+inline float QuarterShift(float f) {
+  float g = f + 0.25f;
+  return g >= 1.0f ? g - 1.0f : g;
+}
+
+struct ScalarSine {
+  static float Eval(float f) { return SinCycles(f); }
+};
+struct ScalarCosine {
+  static float Eval(float f) { return SinCycles(QuarterShift(f)); }
+};
+struct ScalarSquare {
+  static float Eval(float f) { return f < 0.5f ? 1.0f : -1.0f; }
+};
+struct ScalarTriangle {
+  static float Eval(float f) {
+    return 1.0f - 4.0f * std::fabs(QuarterShift(f) - 0.5f);
+  }
+};
+struct ScalarSawtooth {
+  static float Eval(float f) { return 2.0f * f - 1.0f; }
+};
+
+template <typename Shape>
+void ScalarKernel(float* out, size_t n, double phase, double increment,
+                  float amplitude) {
+  phase -= std::floor(phase);
+  increment -= std::floor(increment);
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = amplitude * Shape::Eval(static_cast<float>(phase));
+    phase += increment;
+    if (phase >= 1.0) phase -= 1.0;
+  }
+}
+
+// Band-limited shapes, evaluated in double. Each samples the ideal shape
+// at phase t and adds a two-sample residual around every discontinuity; d
+// is the distance past the discontinuity in cycles and dt the increment.
+
+// Band-limited minus ideal for a unit upward step (PolyBLEP)
+inline double PolyBlep(double d, double dt) {
+  if (d < dt) {
+    const double x = 1.0 - d / dt;
+    return -0.5 * x * x;
+  }
+  if (d > 1.0 - dt) {
+    const double x = 1.0 + (d - 1.0) / dt;
+    return 0.5 * x * x;
+  }
+  return 0.0;
+}
+
+// The same for a corner whose slope grows by one per sample (PolyBLAMP,
+// the integral of the PolyBLEP residual)
+inline double PolyBlamp(double d, double dt) {
+  if (d < dt) {
+    const double x = 1.0 - d / dt;
+    return x * x * x / 6.0;
+  }
+  if (d > 1.0 - dt) {
+    const double x = 1.0 + (d - 1.0) / dt;
+    return x * x * x / 6.0;
+  }
+  return 0.0;
+}
+
+// Fractional part; truncation instead of std::floor, which is a library
+// call without SSE4.1
+inline double Wrap(double t) {
+  t -= static_cast<double>(static_cast<int64_t>(t));
+  return t < 0.0 ? t + 1.0 : t;
+}
+
+struct BandLimitedSquare {
+  static constexpr WaveType TYPE = WaveType::SQUARE;
+  static constexpr double EDGES[] = {0.0, 0.5};
+  static double Eval(double t, double dt) {
+    return (t < 0.5 ? 1.0 : -1.0) + 2.0 * PolyBlep(t, dt) -
+           2.0 * PolyBlep(Wrap(t - 0.5), dt);
+  }
+};
+struct BandLimitedTriangle {
+  static constexpr WaveType TYPE = WaveType::TRIANGLE;
+  // The slope turns from +4 to -4 per cycle at the peak and back at the
+  // trough
+  static constexpr double EDGES[] = {0.25, 0.75};
+  static double Eval(double t, double dt) {
+    return 1.0 - 4.0 * std::fabs(Wrap(t + 0.25) - 0.5) -
+           8.0 * dt * PolyBlamp(Wrap(t - 0.25), dt) +
+           8.0 * dt * PolyBlamp(Wrap(t - 0.75), dt);
+  }
+};
+struct BandLimitedSawtooth {
+  static constexpr WaveType TYPE = WaveType::SAWTOOTH;
+  static constexpr double EDGES[] = {0.0};
+  static double Eval(double t, double dt) {
+    return 2.0 * t - 1.0 - 2.0 * PolyBlep(t, dt);
+  }
+};
+
+template <typename Shape, WaveKernels::Isa ISA>
+void BandLimitedKernel(float* out, size_t n, double phase, double increment,
+                       float amplitude) {
+  WaveKernels::Get(Shape::TYPE, ISA)(out, n, phase, increment, amplitude);
+  phase = Wrap(phase);
+  increment = Wrap(increment);
+  if (increment <= 0.0 || increment > 0.5) return;
+
+  // Crossing m of an edge lies at sample (first + m) / increment; the
+  // samples on either side of it are recomputed in full, so the residuals
+  // of neighbouring edges add up. m = -1 catches an edge just before the
+  // block whose residual reaches sample 0.
+  for (double edge : Shape::EDGES) {
+    const double first = Wrap(edge - phase);
+    for (double m = -1.0;; m += 1.0) {
+      const double below = std::floor((first + m) / increment);
+      if (below >= static_cast<double>(n)) break;
+      for (double i = std::max(below, 0.0); i <= below + 1.0 && i < n; i += 1.0) {
+        const size_t k = static_cast<size_t>(i);
+        const double t = Wrap(phase + static_cast<double>(k) * increment);
+        out[k] = amplitude * static_cast<float>(Shape::Eval(t, increment));
+      }
+    }
+  }
+}
+
+// The band-limited kernel on top of `isa`'s naive kernel
+template <typename Shape>
+WaveKernels::KernelFn BandLimitedKernelFor(WaveKernels::Isa isa) {
+  using WaveKernels::Isa;
+  switch (isa) {
+    case Isa::SCALAR:
+      break;
+    case Isa::SSE2:
+      return BandLimitedKernel<Shape, Isa::SSE2>;
+    case Isa::AVX2:
+      return BandLimitedKernel<Shape, Isa::AVX2>;
+  }
+  return BandLimitedKernel<Shape, Isa::SCALAR>;
+}
+
+#if defined(__SSE2__)
+
+// SSE2 is part of the x86-64 baseline, so no runtime check is needed.
+// Without SSE4.1 there is no floor instruction; phases are non-negative, so
+// truncation is used instead.
+
+inline __m128 Sse2Frac(__m128 p) {
+  return _mm_sub_ps(p, _mm_cvtepi32_ps(_mm_cvttps_epi32(p)));
+}
+
+inline __m128 Sse2SinCycles(__m128 f) {
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 sign_mask = _mm_set1_ps(-0.0f);
+  __m128 wrap = _mm_and_ps(_mm_cmpge_ps(f, half), _mm_set1_ps(1.0f));
+  __m128 x = _mm_sub_ps(f, wrap);
+  __m128 sign = _mm_and_ps(x, sign_mask);
+  __m128 a = _mm_andnot_ps(sign_mask, x);
+  a = _mm_min_ps(a, _mm_sub_ps(half, a));
+  __m128 y = _mm_or_ps(a, sign);
+  __m128 y2 = _mm_mul_ps(y, y);
+  __m128 r = _mm_set1_ps(SIN_C11);
+  r = _mm_add_ps(_mm_mul_ps(r, y2), _mm_set1_ps(SIN_C9));
+  r = _mm_add_ps(_mm_mul_ps(r, y2), _mm_set1_ps(SIN_C7));
+  r = _mm_add_ps(_mm_mul_ps(r, y2), _mm_set1_ps(SIN_C5));
+  r = _mm_add_ps(_mm_mul_ps(r, y2), _mm_set1_ps(SIN_C3));
+  r = _mm_add_ps(_mm_mul_ps(r, y2), _mm_set1_ps(SIN_C1));
+  return _mm_mul_ps(r, y);
+}
+
+inline __m128 Sse2QuarterShift(__m128 f) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  __m128 g = _mm_add_ps(f, _mm_set1_ps(0.25f));
+  return _mm_sub_ps(g, _mm_and_ps(_mm_cmpge_ps(g, one), one));
+}
+
+struct Sse2Sine {
+  using Scalar = ScalarSine;
+  static __m128 Eval(__m128 f) { return Sse2SinCycles(f); }
+};
+struct Sse2Cosine {
+  using Scalar = ScalarCosine;
+  static __m128 Eval(__m128 f) { return Sse2SinCycles(Sse2QuarterShift(f)); }
+};
+struct Sse2Square {
+  using Scalar = ScalarSquare;
+  static __m128 Eval(__m128 f) {
+    __m128 below = _mm_cmplt_ps(f, _mm_set1_ps(0.5f));
+    return _mm_or_ps(_mm_and_ps(below, _mm_set1_ps(1.0f)),
+                     _mm_andnot_ps(below, _mm_set1_ps(-1.0f)));
+  }
+};
+struct Sse2Triangle {
+  using Scalar = ScalarTriangle;
+  static __m128 Eval(__m128 f) {
+    __m128 d = _mm_sub_ps(Sse2QuarterShift(f), _mm_set1_ps(0.5f));
+    d = _mm_andnot_ps(_mm_set1_ps(-0.0f), d);
+    return _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(4.0f), d));
+  }
+};
+struct Sse2Sawtooth {
+  using Scalar = ScalarSawtooth;
+  static __m128 Eval(__m128 f) {
+    return _mm_sub_ps(_mm_add_ps(f, f), _mm_set1_ps(1.0f));
+  }
+};
+
+template <typename Shape>
+void Sse2Kernel(float* out, size_t n, double phase, double increment,
+                float amplitude) {
+  phase -= std::floor(phase);
+  increment -= std::floor(increment);
+  // Each group of 4 lanes starts from the double-precision phase, so float
+  // error never accumulates across groups. The lane offsets are wrapped in
+  // double, which keeps lane phases below 2 cycles, where a float still
+  // resolves 1.2e-7 cycles.
+  auto lane_offset = [increment](int lane) {
+    const double offset = lane * increment;
+    return static_cast<float>(offset - std::floor(offset));
+  };
+  const __m128 offsets = _mm_set_ps(lane_offset(3), lane_offset(2),
+                                    lane_offset(1), 0.0f);
+  const __m128 amp = _mm_set1_ps(amplitude);
+  const double step = 4 * increment;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 p = _mm_add_ps(_mm_set1_ps(static_cast<float>(phase)), offsets);
+    _mm_storeu_ps(out + i, _mm_mul_ps(amp, Shape::Eval(Sse2Frac(p))));
+    phase += step;
+    phase -= static_cast<int>(phase);
+  }
+  ScalarKernel<typename Shape::Scalar>(out + i, n - i, phase, increment,
+                                       amplitude);
+}
+
+#endif  // __SSE2__
+
+WaveKernels::Isa DetectIsa() {
+#if defined(WAVE_KERNELS_AVX2)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return WaveKernels::Isa::AVX2;
+  }
+#endif
+#if defined(__SSE2__)
+  return WaveKernels::Isa::SSE2;
+#else
+  return WaveKernels::Isa::SCALAR;
+#endif
+}
+
+}  // namespace
+
+namespace WaveKernels {
+
+Isa ActiveIsa() {
+  static const Isa isa = DetectIsa();
+  return isa;
+}
+
+const char* IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::SCALAR:
+      return "Scalar";
+    case Isa::SSE2:
+      return "SSE2";
+    case Isa::AVX2:
+      return "AVX2";
+  }
+  return "Unknown";
+}
+
+bool IsSupported(Isa isa) {
+  return static_cast<int>(isa) <= static_cast<int>(ActiveIsa());
+}
+
+KernelFn Get(WaveType type) { return Get(type, ActiveIsa()); }
+
+KernelFn Get(WaveType type, Isa isa) {
+  if (!IsSupported(isa)) isa = Isa::SCALAR;
+#if defined(WAVE_KERNELS_AVX2)
+  if (isa == Isa::AVX2) return detail::Avx2Kernel(type);
+#endif
+#if defined(__SSE2__)
+  if (isa != Isa::SCALAR) {
+    switch (type) {
+      case WaveType::SINE:
+      case WaveType::COMPOSITE:
+        return Sse2Kernel<Sse2Sine>;
+      case WaveType::COSINE:
+        return Sse2Kernel<Sse2Cosine>;
+      case WaveType::SQUARE:
+        return Sse2Kernel<Sse2Square>;
+      case WaveType::TRIANGLE:
+        return Sse2Kernel<Sse2Triangle>;
+      case WaveType::SAWTOOTH:
+        return Sse2Kernel<Sse2Sawtooth>;
+    }
+  }
+#endif
+  return detail::ScalarKernel(type);
+}
+
+KernelFn GetBandLimited(WaveType type) {
+  return GetBandLimited(type, ActiveIsa());
+}
+
+KernelFn GetBandLimited(WaveType type, Isa isa) {
+  if (!IsSupported(isa)) isa = Isa::SCALAR;
+  switch (type) {
+    case WaveType::SQUARE:
+      return BandLimitedKernelFor<BandLimitedSquare>(isa);
+    case WaveType::TRIANGLE:
+      return BandLimitedKernelFor<BandLimitedTriangle>(isa);
+    case WaveType::SAWTOOTH:
+      return BandLimitedKernelFor<BandLimitedSawtooth>(isa);
+    case WaveType::SINE:
+    case WaveType::COSINE:
+    case WaveType::COMPOSITE:
+      break;
+  }
+  return Get(type, isa);
+}
+
+namespace detail {
+
+KernelFn ScalarKernel(WaveType type) {
+  switch (type) {
+    case WaveType::SINE:
+    case WaveType::COMPOSITE:
+      return ::ScalarKernel<ScalarSine>;
+    case WaveType::COSINE:
+      return ::ScalarKernel<ScalarCosine>;
+    case WaveType::SQUARE:
+      return ::ScalarKernel<ScalarSquare>;
+    case WaveType::TRIANGLE:
+      return ::ScalarKernel<ScalarTriangle>;
+    case WaveType::SAWTOOTH:
+      return ::ScalarKernel<ScalarSawtooth>;
+  }
+  return ::ScalarKernel<ScalarSine>;
+}
+
+}  // namespace detail
+
+}  // namespace WaveKernels
@@ -0,0 +1,136 @@
+// AVX2 + FMA waveform kernels. This file is compiled with -mavx2 -mfma when
+// WAVE_KERNELS_AVX2 is defined; WaveKernels::Get() only hands these out
+// after a runtime CPU check. Keep it free of inline library code so no AVX
+// instructions leak into functions shared with other translation units.
+
+#include "WaveKernelsDetail.hpp"
+
+#if defined(WAVE_KERNELS_AVX2)
+
+#include <immintrin.h>
+
+namespace {
+
+using WaveKernels::detail::SIN_C1;
+using WaveKernels::detail::SIN_C3;
+using WaveKernels::detail::SIN_C5;
+using WaveKernels::detail::SIN_C7;
+using WaveKernels::detail::SIN_C9;
+using WaveKernels::detail::SIN_C11;
+
+inline __m256 Frac(__m256 p) { return _mm256_sub_ps(p, _mm256_floor_ps(p)); }
+
+inline __m256 SinCycles(__m256 f) {
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+  __m256 wrap = _mm256_and_ps(_mm256_cmp_ps(f, half, _CMP_GE_OQ),
+                              _mm256_set1_ps(1.0f));
+  __m256 x = _mm256_sub_ps(f, wrap);
+  __m256 sign = _mm256_and_ps(x, sign_mask);
+  __m256 a = _mm256_andnot_ps(sign_mask, x);
+  a = _mm256_min_ps(a, _mm256_sub_ps(half, a));
+  __m256 y = _mm256_or_ps(a, sign);
+  __m256 y2 = _mm256_mul_ps(y, y);
+  __m256 r = _mm256_set1_ps(SIN_C11);
+  r = _mm256_fmadd_ps(r, y2, _mm256_set1_ps(SIN_C9));
+  r = _mm256_fmadd_ps(r, y2, _mm256_set1_ps(SIN_C7));
+  r = _mm256_fmadd_ps(r, y2, _mm256_set1_ps(SIN_C5));
+  r = _mm256_fmadd_ps(r, y2, _mm256_set1_ps(SIN_C3));
+  r = _mm256_fmadd_ps(r, y2, _mm256_set1_ps(SIN_C1));
+  return _mm256_mul_ps(r, y);
+}
+
+inline __m256 QuarterShift(__m256 f) {
+  return Frac(_mm256_add_ps(f, _mm256_set1_ps(0.25f)));
+}
+
+struct Sine {
+  static constexpr WaveType TYPE = WaveType::SINE;
+  static __m256 Eval(__m256 f) { return SinCycles(f); }
+};
+struct Cosine {
+  static constexpr WaveType TYPE = WaveType::COSINE;
+  static __m256 Eval(__m256 f) { return SinCycles(QuarterShift(f)); }
+};
+struct Square {
+  static constexpr WaveType TYPE = WaveType::SQUARE;
+  static __m256 Eval(__m256 f) {
+    __m256 below = _mm256_cmp_ps(f, _mm256_set1_ps(0.5f), _CMP_LT_OQ);
+    return _mm256_blendv_ps(_mm256_set1_ps(-1.0f), _mm256_set1_ps(1.0f),
+                            below);
+  }
+};
+struct Triangle {
+  static constexpr WaveType TYPE = WaveType::TRIANGLE;
+  static __m256 Eval(__m256 f) {
+    __m256 d = _mm256_sub_ps(QuarterShift(f), _mm256_set1_ps(0.5f));
+    d = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), d);
+    return _mm256_fnmadd_ps(_mm256_set1_ps(4.0f), d, _mm256_set1_ps(1.0f));
+  }
+};
+struct Sawtooth {
+  static constexpr WaveType TYPE = WaveType::SAWTOOTH;
+  static __m256 Eval(__m256 f) {
+    return _mm256_fmsub_ps(_mm256_set1_ps(2.0f), f, _mm256_set1_ps(1.0f));
+  }
+};
+
+template <typename Shape>
+void Kernel(float* out, size_t n, double phase, double increment,
+            float amplitude) {
+  // Wrap to [0, 1) without calling into libm
+  phase -= static_cast<long long>(phase);
+  if (phase < 0) phase += 1.0;
+  increment -= static_cast<long long>(increment);
+  if (increment < 0) increment += 1.0;
+  // Each group of 8 lanes starts from the double-precision phase, so float
+  // error never accumulates across groups. The lane offsets are wrapped in
+  // double, which keeps lane phases below 2 cycles, where a float still
+  // resolves 1.2e-7 cycles.
+  float lane_offsets[8];
+  for (int j = 0; j < 8; ++j) {
+    const double offset = j * increment;
+    lane_offsets[j] =
+        static_cast<float>(offset - static_cast<long long>(offset));
+  }
+  const __m256 offsets = _mm256_loadu_ps(lane_offsets);
+  const __m256 amp = _mm256_set1_ps(amplitude);
+  const double step = 8 * increment;
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 p = _mm256_add_ps(_mm256_set1_ps(static_cast<float>(phase)),
+                             offsets);
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(amp, Shape::Eval(Frac(p))));
+    phase += step;
+    phase -= static_cast<long long>(phase);
+  }
+  if (i < n) {
+    WaveKernels::detail::ScalarKernel(Shape::TYPE)(out + i, n - i, phase,
+                                                   increment, amplitude);
+  }
+}
+
+}  // namespace
+
+namespace WaveKernels::detail {
+
+KernelFn Avx2Kernel(WaveType type) {
+  switch (type) {
+    case WaveType::SINE:
+    case WaveType::COMPOSITE:
+      return Kernel<Sine>;
+    case WaveType::COSINE:
+      return Kernel<Cosine>;
+    case WaveType::SQUARE:
+      return Kernel<Square>;
+    case WaveType::TRIANGLE:
+      return Kernel<Triangle>;
+    case WaveType::SAWTOOTH:
+      return Kernel<Sawtooth>;
+  }
+  return Kernel<Sine>;
+}
+
+}  // namespace WaveKernels::detail
+
+#endif  // WAVE_KERNELS_AVX2
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "WaveKernels.hpp"
+
+// Internal to the kernel translation units
+namespace WaveKernels::detail {
+
+// sin(2 * pi * x) = x * (C1 + x^2 * (C3 + ... + x^2 * C11)) for |x| <= 0.25,
+// i.e. the Taylor series of sin(theta) up to theta^11 with x in cycles
+constexpr float SIN_C1 = 6.283185307179586f;
+constexpr float SIN_C3 = -41.341702240399755f;
+constexpr float SIN_C5 = 81.60524927607504f;
+constexpr float SIN_C7 = -76.70585975306136f;
+constexpr float SIN_C9 = 42.058693944897634f;
+constexpr float SIN_C11 = -15.094642576822984f;
+
+KernelFn ScalarKernel(WaveType type);
+
+// Defined in WaveKernelsAvx2.cpp, which is compiled with -mavx2 -mfma and
+// must only be called after a runtime CPU check
+KernelFn Avx2Kernel(WaveType type);
+
+}  // namespace WaveKernels::detail
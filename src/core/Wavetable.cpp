@@ -0,0 +1,175 @@
+#include "Wavetable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include "Trace.hpp"
+
+namespace {
+
+using Wavetable::LEVELS;
+using Wavetable::TABLE_SIZE;
+
+constexpr size_t WAVE_TYPE_COUNT = 5;  // The fixed shapes
+constexpr size_t GUARD_BEFORE = 1;
+constexpr size_t STRIDE = TABLE_SIZE + 3;  // Table plus guard samples
+
+// Fourier coefficients of the unit shapes in the phase convention of the
+// kernels: shape(t) = sum over h of s_h sin(2 pi h t) + c_h cos(2 pi h t)
+void Coefficients(WaveType type, size_t h, double& s, double& c) {
+  s = 0.0;
+  c = 0.0;
+  const bool odd = h % 2 == 1;
+  switch (type) {
+    case WaveType::SINE:
+      s = h == 1 ? 1.0 : 0.0;
+      break;
+    case WaveType::COSINE:
+      c = h == 1 ? 1.0 : 0.0;
+      break;
+    case WaveType::SQUARE:
+      s = odd ? 4.0 / (M_PI * h) : 0.0;
+      break;
+    case WaveType::TRIANGLE:
+      s = odd ? ((h / 2) % 2 == 0 ? 1.0 : -1.0) * 8.0 / (M_PI * M_PI * h * h) : 0.0;
+      break;
+    case WaveType::SAWTOOTH:
+      s = -2.0 / (M_PI * h);
+      break;
+    case WaveType::COMPOSITE:
+      break;
+  }
+}
+
+struct Tables {
+  // [type][level][STRIDE]
+  std::vector<float> data;
+
+  Tables() : data(WAVE_TYPE_COUNT * LEVELS * STRIDE) {
+    TRACE_SCOPE("Wavetable::Build");
+    std::vector<double> sum(TABLE_SIZE);
+    std::vector<std::complex<double>> rotor(TABLE_SIZE);
+    std::vector<std::complex<double>> step(TABLE_SIZE);
+    for (size_t i = 0; i < TABLE_SIZE; ++i) {
+      step[i] = std::polar(1.0, 2.0 * M_PI * static_cast<double>(i) / TABLE_SIZE);
+    }
+    for (size_t type = 0; type < WAVE_TYPE_COUNT; ++type) {
+      // Add harmonics from the lowest up; after harmonic H is added, sum
+      // holds the series of every level that keeps H harmonics
+      std::fill(sum.begin(), sum.end(), 0.0);
+      for (size_t i = 0; i < TABLE_SIZE; ++i) rotor[i] = 1.0;
+      size_t level = LEVELS;
+      for (size_t h = 1; h <= Wavetable::MAX_HARMONICS; ++h) {
+        double s, c;
+        Coefficients(static_cast<WaveType>(type), h, s, c);
+        for (size_t i = 0; i < TABLE_SIZE; ++i) {
+          // exp(2 pi i h t), advanced one harmonic per step
+          rotor[i] *= step[i];
+          sum[i] += s * rotor[i].imag() + c * rotor[i].real();
+        }
+        while (level > 0 && Wavetable::HarmonicCount(level - 1) == h) {
+          --level;
+          Store(type, level, sum);
+        }
+        if (level == 0) break;
+      }
+    }
+  }
+
+  void Store(size_t type, size_t level, const std::vector<double>& sum) {
+    float* table = data.data() + (type * LEVELS + level) * STRIDE + GUARD_BEFORE;
+    for (size_t i = 0; i < TABLE_SIZE; ++i) table[i] = static_cast<float>(sum[i]);
+    table[-1] = table[TABLE_SIZE - 1];
+    table[TABLE_SIZE] = table[0];
+    table[TABLE_SIZE + 1] = table[1];
+  }
+};
+
+const Tables& GetTables() {
+  static const Tables tables;
+  return tables;
+}
+
+// Phase as a 32-bit fraction of a cycle: the top bits index the table and
+// the rest is the interpolation position, and wrapping is free
+constexpr int INDEX_BITS = 11;  // log2(TABLE_SIZE)
+static_assert(size_t{1} << INDEX_BITS == TABLE_SIZE);
+constexpr int FRACTION_BITS = 32 - INDEX_BITS;
+constexpr float FRACTION_SCALE = 1.0f / (1u << FRACTION_BITS);
+
+inline uint32_t ToFixed(double cycles) {
+  cycles -= std::floor(cycles);
+  return static_cast<uint32_t>(static_cast<uint64_t>(cycles * 4294967296.0));
+}
+
+template <WaveType TYPE, bool CUBIC>
+void TableKernel(float* out, size_t n, double phase, double increment,
+                 float amplitude) {
+  increment -= std::floor(increment);
+  const float* table = Wavetable::GetTable(TYPE, Wavetable::SelectLevel(increment));
+  uint32_t position = ToFixed(phase);
+  const uint32_t step = ToFixed(increment);
+  for (size_t i = 0; i < n; ++i) {
+    const uint32_t index = position >> FRACTION_BITS;
+    const float x = static_cast<float>(position & ((1u << FRACTION_BITS) - 1)) * FRACTION_SCALE;
+    const float* p = table + index;
+    float value;
+    if constexpr (CUBIC) {
+      // Catmull-Rom through p[-1], p[0], p[1], p[2]
+      const float a = 0.5f * (p[2] - p[-1]) + 1.5f * (p[0] - p[1]);
+      const float b = p[-1] - 2.5f * p[0] + 2.0f * p[1] - 0.5f * p[2];
+      const float c = 0.5f * (p[1] - p[-1]);
+      value = ((a * x + b) * x + c) * x + p[0];
+    } else {
+      value = p[0] + x * (p[1] - p[0]);
+    }
+    out[i] = amplitude * value;
+    position += step;
+  }
+}
+
+template <bool CUBIC>
+WaveKernels::KernelFn KernelFor(WaveType type) {
+  switch (type) {
+    case WaveType::SINE:
+    case WaveType::COMPOSITE:
+      return TableKernel<WaveType::SINE, CUBIC>;
+    case WaveType::COSINE:
+      return TableKernel<WaveType::COSINE, CUBIC>;
+    case WaveType::SQUARE:
+      return TableKernel<WaveType::SQUARE, CUBIC>;
+    case WaveType::TRIANGLE:
+      return TableKernel<WaveType::TRIANGLE, CUBIC>;
+    case WaveType::SAWTOOTH:
+      return TableKernel<WaveType::SAWTOOTH, CUBIC>;
+  }
+  return TableKernel<WaveType::SINE, CUBIC>;
+}
+
+}  // namespace
+
+namespace Wavetable {
+
+void Prepare() { GetTables(); }
+
+size_t SelectLevel(double increment) {
+  // Level k is safe when (MAX_HARMONICS >> k) * increment <= 0.5
+  const double top = 2.0 * MAX_HARMONICS * increment;
+  if (top <= 1.0) return 0;
+  const size_t level = static_cast<size_t>(std::ceil(std::log2(top)));
+  return std::min(level, LEVELS - 1);
+}
+
+const float* GetTable(WaveType type, size_t level) {
+  return GetTables().data.data() +
+         (static_cast<size_t>(type) * LEVELS + level) * STRIDE + GUARD_BEFORE;
+}
+
+WaveKernels::KernelFn GetKernel(WaveType type, bool cubic) {
+  return cubic ? KernelFor<true>(type) : KernelFor<false>(type);
+}
+
+}  // namespace Wavetable
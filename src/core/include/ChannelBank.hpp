@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MinMaxPyramid.hpp"
+#include "OscillatorBank.hpp"
+#include "RingBuffer.hpp"
+#include "SampleView.hpp"
+
+class ThreadPool;
+
+// An OscillatorBank with a display history per channel.
+//
+// Every channel has its own ring buffer and min/max pyramid, so any subset
+// can be drawn with the same geometry code as the main waveform. Advance()
+// generates and appends in one pass per channel on the pool, so the
+// histories are filled by the thread that generated the samples. Once the
+// bank has modulation routes the channels depend on each other, so
+// Advance() instead generates all channels one short block at a time and
+// appends each block afterwards.
+class ChannelBank {
+ public:
+  static constexpr size_t DEFAULT_CHANNELS = 64;
+  static constexpr size_t DEFAULT_HISTORY_CAPACITY = 4096;
+
+  ChannelBank();
+
+  // Resize the bank; changing the history capacity drops every history
+  void Resize(size_t channels, size_t history_capacity);
+  size_t GetChannelCount() const { return channels_.size(); }
+  size_t GetHistoryCapacity() const { return history_capacity_; }
+
+  OscillatorBank& GetOscillators() { return oscillators_; }
+  const OscillatorBank& GetOscillators() const { return oscillators_; }
+
+  // Generate `count` samples per channel at `sample_rate` and append them to
+  // the histories. Runs on the caller without a pool.
+  void Advance(size_t count, double sample_rate, ThreadPool* pool);
+
+  // Zero-copy view of one channel's history (oldest first). Versions are
+  // distinct across channels, so caches keyed by the version never confuse
+  // two channels.
+  SampleView GetSamples(size_t channel) const;
+  const MinMaxPyramid& GetPyramid(size_t channel) const {
+    return channels_[channel].pyramid;
+  }
+
+  // Samples generated per channel since startup
+  uint64_t GetTotalSamples() const { return total_samples_; }
+
+ private:
+  struct Channel {
+    RingBuffer<float> history;
+    MinMaxPyramid pyramid;
+  };
+
+  // Generation block per channel, bounded so the scratch stays in cache
+  static constexpr size_t BLOCK_SIZE = 4096;
+  // Bank-wide block with modulation routes; also the delay of modulated
+  // sources
+  static constexpr size_t MODULATED_BLOCK_SIZE = 256;
+
+  void AdvanceModulated(size_t count, double sample_rate, ThreadPool* pool);
+
+  OscillatorBank oscillators_;
+  std::vector<Channel> channels_;
+  std::vector<float> modulated_block_;  // Channel c at c * block size
+  size_t history_capacity_ = 0;
+  uint64_t version_ = 0;
+  uint64_t total_samples_ = 0;
+};
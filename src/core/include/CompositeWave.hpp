@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// One sine component of a composite wave
+struct Partial {
+  float ratio = 1.f;      // Frequency relative to the fundamental
+  float amplitude = 1.f;  // Relative to the wave amplitude
+  float phase = 0.f;      // Offset in radians
+
+  bool operator==(const Partial&) const = default;
+};
+
+// Partials of WaveType::COMPOSITE and the additive synthesis that sums them.
+//
+// Render() runs a bank of rotating phasors: every partial is a complex
+// number that is multiplied by its per-sample rotation, so a sample costs
+// one complex multiply-add per partial instead of a sin() call. With SSE2,
+// four partials and four samples are handled per step. The phasors are
+// re-anchored from the double-precision phase every ANCHOR_INTERVAL
+// samples, so float rounding cannot build up over long blocks. Partials at
+// or above Nyquist are skipped, so the sum is band-limited in every
+// generation mode.
+//
+// A set never changes after construction; the UI publishes edits as a new
+// set, and WaveParams share sets through std::shared_ptr across threads.
+class CompositeWave {
+ public:
+  static constexpr size_t MAX_PARTIALS = 256;
+  static constexpr size_t ANCHOR_INTERVAL = 1024;
+  static constexpr float MAX_RATIO = 256.f;
+  static constexpr int RATIO_BITS = 20;
+
+  // Keeps the first MAX_PARTIALS partials. Ratios are clamped to
+  // [0, MAX_RATIO] and rounded to multiples of 2^-RATIO_BITS, so every
+  // partial completes whole cycles over Oscillator::PHASE_PERIOD
+  // fundamental cycles.
+  explicit CompositeWave(std::vector<Partial> partials);
+
+  // `count` partials at ratios 1, 1 + step, 1 + 2 * step, ... with
+  // amplitude 1 / ratio: the Fourier series of a sawtooth for step 1 and of
+  // a square for step 2
+  static std::vector<Partial> HarmonicSeries(size_t count, size_t step = 1);
+
+  const std::vector<Partial>& GetPartials() const { return partials_; }
+
+  // Largest magnitude at unit amplitude (the sum of |amplitude|)
+  float GetPeak() const { return peak_; }
+
+  // Same contract as a WaveKernels kernel: n samples of the unit wave
+  // scaled by `amplitude`, sample i at phase + i * increment cycles of the
+  // fundamental. Unlike the fixed shapes, the whole phase and increment
+  // matter when ratios are not integers; a partial is skipped when its own
+  // rotation per sample reaches Nyquist. A negative increment, as FM
+  // through zero gives, turns the partials backwards.
+  void Render(float* out, size_t n, double phase, double increment,
+              float amplitude) const;
+
+  // One sample at `phase` cycles with std::sin per partial, for the
+  // per-sample reference generator. Nothing is skipped.
+  float Evaluate(double phase) const;
+
+ private:
+  std::vector<Partial> partials_;
+  float peak_ = 0.f;
+};
+
+using CompositeWavePtr = std::shared_ptr<const CompositeWave>;
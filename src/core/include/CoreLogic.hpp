@@ -3,13 +3,13 @@
 #include <cmath>  // For sine function
 #include <vector>
 
-enum class WaveType {
-  SINE = 0,
-  COSINE,
-  SQUARE,
-  TRIANGLE,
-  SAWTOOTH
-};
+#include "MinMaxPyramid.hpp"
+#include "Oscillator.hpp"
+#include "RingBuffer.hpp"
+#include "RunningStats.hpp"
+#include "SampleSink.hpp"
+#include "SampleView.hpp"
+#include "WaveType.hpp"
 
 class CoreLogic {
  public:
@@ -18,12 +18,42 @@ class CoreLogic {
   // Method to update sine wave values based on frequency and amplitude
   void Update();
 
+  // Generate `count` consecutive samples in one batch and append them to the
+  // history, advancing the simulation by count / fps seconds
+  void Advance(size_t count);
+
+  // Append samples generated elsewhere (e.g. by the simulation thread)
+  void PushSamples(const float* values, size_t count);
+
+  // Fill `out` with the next n samples of the current waveform, one every
+  // 1 / fps seconds. The wave type and noise dispatch happen once per block
+  // instead of once per sample.
+  void GenerateBlock(float* out, size_t n);
+
+  // Snapshot of the current waveform parameters
+  WaveParams GetParameters() const {
+    return {wave_type_, frequency_, amplitude_, phase_, noise_,
+            noise_type_, generation_mode_, composite_};
+  };
+
   float& GetFrequency() { return frequency_; };
   float& GetAmplitude() { return amplitude_; };
   float& GetFps() { return fps_; };
   float& GetPhase() { return phase_; };
   float& GetNoise() { return noise_; };
+  NoiseType& GetNoiseType() { return noise_type_; };
+  GenerationMode& GetGenerationMode() { return generation_mode_; };
+
+  // Restart the noise sequences; equal seeds reproduce runs bit for bit.
+  // A Simulation thread has its own generator, see Simulation::Reseed().
+  void SetNoiseSeed(uint64_t seed);
+  uint64_t GetNoiseSeed() const { return noise_seed_; }
   WaveType& GetWaveType() { return wave_type_; };
+
+  // Partials of WaveType::COMPOSITE. The set is immutable; SetPartials()
+  // replaces it, and threads holding the old one keep it alive.
+  const CompositeWavePtr& GetComposite() const { return composite_; };
+  void SetPartials(std::vector<Partial> partials);
   
   // Color getters/setters
   float* GetWaveColor() { return wave_color_; };
@@ -35,29 +65,76 @@ class CoreLogic {
     bg_color_[0] = r; bg_color_[1] = g; bg_color_[2] = b; 
   };
 
-  // Getter for sine wave values
-  inline const std::vector<float> GetSineWaveValues() const {
-    return sine_wave_values_;
+  // Zero-copy view of the sample history (oldest first). Valid until the
+  // next Update() or history change.
+  inline SampleView GetSamples() const {
+    return {sine_wave_values_.FirstSegment(),
+            sine_wave_values_.SecondSegment(), version_};
   };
 
+  // Min/max decimation of the history, for drawing long histories
+  inline const MinMaxPyramid& GetPyramid() const { return pyramid_; };
+
+  // Min/max/mean/variance/RMS of the history, updated as samples arrive
+  inline const RunningStats& GetStats() const { return stats_; };
+
+  // Incremented whenever the history changes
+  inline uint64_t GetVersion() const { return version_; };
+
+  // Sinks see every appended sample, e.g. to record it. Not owned.
+  void AddSink(SampleSink* sink);
+  void RemoveSink(SampleSink* sink);
+
+  // History length in samples; changing it drops the current history
+  void SetHistoryCapacity(size_t capacity);
+  size_t GetHistoryCapacity() const { return sine_wave_values_.Capacity(); };
+
+  static constexpr size_t DEFAULT_HISTORY_CAPACITY = 500;
+  static constexpr size_t MIN_HISTORY_CAPACITY = 2;
+  static constexpr size_t MAX_HISTORY_CAPACITY = 16 * 1024 * 1024;
+  static constexpr size_t DEFAULT_PARTIALS = 8;
+
+  // Reference per-sample generator (one switch and std::sin per call). Not
+  // used by the simulation; kept as the baseline for the benchmarks. It
+  // always generates the naive shapes.
+  float GenerateWaveValue(float time);
+
+  // GenerateWaveValue() for the n times start_time + i * sample_period,
+  // through a Generator specialized for the wave type and the noise setting
+  void GenerateWaveBlock(double start_time, double sample_period, float* out,
+                         size_t n);
+
  private:
-  static constexpr size_t MAX_VALUES = 500;
-  
-  // Wave generation function
-  float GenerateWaveValue(float time) const;
   
   // Simulation parameters
   float frequency_ = 1.f;
   float amplitude_ = 1.f;
   float phase_ = 0.f;
   float noise_ = 0.f;
-  float time_;
+  NoiseType noise_type_ = NoiseType::UNIFORM;
+  GenerationMode generation_mode_ = GenerationMode::NAIVE;
   float fps_ = 60.f;
   WaveType wave_type_ = WaveType::SINE;
+  CompositeWavePtr composite_;
+  uint64_t noise_seed_ = NoiseGenerator::DEFAULT_SEED;
   
   // Color parameters
   float wave_color_[3] = {0.26f, 0.59f, 0.98f}; // Default blue
   float bg_color_[3] = {0.12f, 0.14f, 0.18f};   // Default dark gray
   
-  std::vector<float> sine_wave_values_;
+  // Phase accumulator driving GenerateBlock()
+  Oscillator oscillator_;
+  // Noise of GenerateWaveValue() and GenerateWaveBlock()
+  NoiseGenerator reference_noise_;
+
+  RingBuffer<float> sine_wave_values_;
+  MinMaxPyramid pyramid_;
+  RunningStats stats_;
+  uint64_t version_ = 0;
+  uint64_t total_samples_ = 0;  // Samples appended since startup
+
+  std::vector<SampleSink*> sinks_;
+
+  // Scratch buffer reused by Advance()
+  std::vector<float> block_buffer_;
 };
\ No newline at end of file
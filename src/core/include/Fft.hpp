@@ -0,0 +1,30 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// Radix-2 FFT of real input.
+//
+// A real transform of size N is computed as a complex transform of size N/2
+// over the interleaved even/odd samples, followed by a split step. Twiddle
+// factors and the bit-reversal permutation are computed once in Resize()
+// and reused by every Forward() call, which performs no allocation.
+class RealFft {
+ public:
+  explicit RealFft(size_t size = 0);
+
+  // Prepare tables for `size` real samples; size must be a power of two >= 4
+  void Resize(size_t size);
+  size_t GetSize() const { return size_; }
+
+  // Transform `size` real samples into size / 2 + 1 bins, DC to Nyquist
+  void Forward(const float* in, std::complex<float>* out);
+
+ private:
+  size_t size_ = 0;
+  std::vector<std::complex<float>> twiddles_;        // exp(-2 pi i k / (N/2))
+  std::vector<std::complex<float>> split_twiddles_;  // exp(-2 pi i k / N)
+  std::vector<size_t> bit_reverse_;
+  std::vector<std::complex<float>> work_;
+};
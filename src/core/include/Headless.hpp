@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "Oscillator.hpp"
+#include "WavWriter.hpp"
+
+// Command-line batch generation without SDL or ImGui.
+//
+//   sine-simulator --headless --wave square --freq 440 --duration 60 --out x.wav
+//
+// The output format follows the file extension: .wav (see --format), .csv,
+// or raw little-endian float32 for anything else; "-" writes raw float32 to
+// stdout. Samples are generated in large oscillator blocks at maximum
+// throughput, and a summary is printed to stderr. Runs with the same
+// options (including --seed) produce identical files.
+struct HeadlessOptions {
+  WaveParams params;
+  uint32_t sample_rate = 48000;
+  double duration = 10.0;  // Seconds
+  WavFormat format = WavFormat::PCM16;
+  uint64_t seed = NoiseGenerator::DEFAULT_SEED;
+  std::string out;
+};
+
+// True if argv contains --headless
+bool IsHeadlessRequested(int argc, char* argv[]);
+
+// Parse the options after the program name; prints the problem and returns
+// false on invalid input
+bool ParseHeadlessOptions(int argc, char* argv[], HeadlessOptions& options);
+
+// Entry point of the headless mode; returns the process exit code
+int RunHeadless(int argc, char* argv[]);
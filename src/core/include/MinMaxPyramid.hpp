@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SampleView.hpp"
+
+struct MinMax {
+  float min;
+  float max;
+};
+
+// Multi-resolution min/max decimation of the sample history.
+//
+// Level 0 summarizes blocks of BASE_BLOCK samples, and each further level
+// merges FANOUT blocks of the level below. Each level is a ring sized to
+// cover the history capacity, so it is maintained incrementally as samples
+// are pushed (amortized O(1) per sample) and never rebuilt. A range query
+// combines complete blocks from the coarsest useful level with finer blocks
+// and raw samples at the edges, so its cost depends on the level count, not
+// on the number of samples in the range.
+class MinMaxPyramid {
+ public:
+  static constexpr size_t BASE_BLOCK = 8;
+  static constexpr size_t FANOUT = 8;
+
+  // Drop everything and size the levels for `history_capacity` samples
+  void Reset(size_t history_capacity);
+
+  void Push(float value);
+
+  // Min/max of view[first, last). `view` must be the history this pyramid
+  // was fed, i.e. its newest sample is the last one pushed here.
+  MinMax Query(const SampleView& view, size_t first, size_t last) const;
+
+  size_t GetLevelCount() const { return levels_.size(); }
+
+ private:
+  struct Level {
+    std::vector<MinMax> blocks;  // Ring indexed by block number
+    size_t block_size = 0;       // Samples per block
+    uint64_t completed = 0;      // Number of finished blocks
+    MinMax pending{0.f, 0.f};    // Block under construction
+    size_t pending_count = 0;    // Inputs merged into `pending`
+  };
+
+  void Accumulate(size_t level, MinMax value);
+  void QueryLevel(int level, const SampleView& view, uint64_t view_start,
+                  uint64_t first, uint64_t last, MinMax& result) const;
+
+  std::vector<Level> levels_;
+  uint64_t total_ = 0;  // Samples pushed since Reset()
+};
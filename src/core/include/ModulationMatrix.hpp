@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Parameter of the destination oscillator a route drives
+enum class ModTarget {
+  FREQUENCY = 0,  // f * (1 + depth * source): FM, depth relative to f
+  AMPLITUDE,      // a * (1 + depth * source): AM, depth is the index
+  PHASE           // phase + depth * source radians: PM
+};
+
+// One connection: the output of channel `source` scaled by `depth` drives
+// `target` of channel `destination`
+struct ModRoute {
+  uint32_t source = 0;
+  uint32_t destination = 1;
+  ModTarget target = ModTarget::FREQUENCY;
+  float depth = 0.5f;
+
+  bool operator==(const ModRoute&) const = default;
+};
+
+// Routes between the channels of an OscillatorBank.
+//
+// Any channel may modulate any other, itself included, and a destination
+// sums every route to the same target. The bank evaluates the routes per
+// block in two stages: channels that nothing modulates are generated
+// first, then every modulated channel reads its sources' blocks and
+// generates with its summed per-sample modulation. A source that is
+// itself modulated contributes its previous block, which makes chains and
+// feedback loops well defined at the cost of one block of delay.
+//
+// Routes naming channels the bank does not have are kept but ignored.
+class ModulationMatrix {
+ public:
+  static constexpr size_t MAX_ROUTES = 256;
+
+  // False when the matrix is full
+  bool AddRoute(const ModRoute& route);
+  void RemoveRoute(size_t index);
+  void Clear() { routes_.clear(); }
+
+  const std::vector<ModRoute>& GetRoutes() const { return routes_; }
+  ModRoute& GetRoute(size_t index) { return routes_[index]; }
+  bool IsEmpty() const { return routes_.empty(); }
+
+  // sum[i] += depth * source[i], the per-route step of building a
+  // destination's modulation
+  static void Accumulate(const float* source, float depth, float* sum,
+                         size_t n);
+
+ private:
+  std::vector<ModRoute> routes_;
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Distribution of the noise added to a waveform
+enum class NoiseType { UNIFORM = 0, GAUSSIAN };
+
+// Seedable pseudo-random noise for the oscillators.
+//
+// The generator runs LANES independent xoshiro128+ streams side by side,
+// with the state stored lane-major, so one step of all lanes is a handful
+// of vector integer operations (SSE2 where available, like the wave
+// kernels). A generator is owned by one oscillator or bank channel and
+// takes no locks.
+//
+// The lanes are seeded from (seed, stream) through splitmix64, so equal
+// seeds reproduce the same sequence bit for bit and different streams
+// (e.g. bank channels) are uncorrelated. The SSE2 and portable paths
+// perform the same float operations in the same order, so they produce
+// identical output.
+//
+// Uniform noise lies in [-1, 1). Gaussian noise has unit variance and is
+// produced with the Box-Muller transform using polynomial log, sine and
+// cosine; it is bounded by GAUSSIAN_PEAK because the radius is computed
+// from 24-bit uniforms.
+class NoiseGenerator {
+ public:
+  static constexpr size_t LANES = 8;
+  static constexpr uint64_t DEFAULT_SEED = 0x5EEDF00DCAFEBEEFull;
+  static constexpr float GAUSSIAN_PEAK = 5.8f;
+
+  explicit NoiseGenerator(uint64_t seed = DEFAULT_SEED, uint64_t stream = 0) {
+    Seed(seed, stream);
+  }
+
+  void Seed(uint64_t seed, uint64_t stream = 0);
+
+  // Fill(), Add() and Next() read one stream per type: the part of a
+  // batch a call does not use is kept for the next call, so the output
+  // does not depend on how the samples are split into blocks. Switching
+  // the type drops the kept values.
+
+  // out[i] = noise
+  void Fill(NoiseType type, float* out, size_t n);
+  // out[i] += scale * noise
+  void Add(NoiseType type, float* out, size_t n, float scale);
+  // One value, for per-sample code paths
+  float Next(NoiseType type);
+
+  // Largest magnitude the distribution produces
+  static float Peak(NoiseType type) {
+    return type == NoiseType::GAUSSIAN ? GAUSSIAN_PEAK : 1.f;
+  }
+
+ private:
+  // Next LANES * PAIRS raw outputs
+  static constexpr size_t PAIRS = 2;
+  static constexpr size_t BATCH = LANES * PAIRS;
+  void NextBatch(float* out, NoiseType type);
+  void NextRaw(uint32_t* out);
+
+  alignas(32) uint32_t s0_[LANES];
+  alignas(32) uint32_t s1_[LANES];
+  alignas(32) uint32_t s2_[LANES];
+  alignas(32) uint32_t s3_[LANES];
+
+  float buffer_[BATCH];
+  size_t buffered_ = 0;
+  NoiseType buffered_type_ = NoiseType::UNIFORM;
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "CompositeWave.hpp"
+#include "NoiseGenerator.hpp"
+#include "WaveKernels.hpp"
+#include "WaveType.hpp"
+#include "Wavetable.hpp"
+
+// Waveform parameters, as edited in the UI
+struct WaveParams {
+  WaveType wave_type = WaveType::SINE;
+  float frequency = 1.f;  // Hz
+  float amplitude = 1.f;
+  float phase = 0.f;  // Offset in radians
+  float noise = 0.f;  // Relative to amplitude
+  NoiseType noise_type = NoiseType::UNIFORM;
+  GenerationMode generation = GenerationMode::NAIVE;
+  // Partials of WaveType::COMPOSITE; without a set it is a plain sine
+  CompositeWavePtr composite;
+
+  // Largest magnitude these parameters can produce
+  float Peak() const {
+    const bool table = generation == GenerationMode::WAVETABLE_LINEAR ||
+                       generation == GenerationMode::WAVETABLE_CUBIC;
+    float shape = table ? Wavetable::PEAK : 1.f;
+    if (wave_type == WaveType::COMPOSITE && composite) {
+      shape = composite->GetPeak();
+    }
+    return amplitude * (shape + noise * NoiseGenerator::Peak(noise_type));
+  }
+
+  bool operator==(const WaveParams&) const = default;
+};
+
+// Per-sample modulation of one block, as summed from a ModulationMatrix.
+// A null buffer leaves that parameter alone.
+struct ModulationInput {
+  const float* frequency = nullptr;  // Relative: f * (1 + m)
+  const float* amplitude = nullptr;  // Relative: a * (1 + m)
+  const float* phase = nullptr;      // Radians added to the offset
+};
+
+// Phase-accumulator oscillator.
+//
+// The running phase is kept in double precision, in cycles, and wrapped to
+// [0, PHASE_PERIOD) after every block, so it never grows with run time and
+// the waveform stays exact over multi-day runs (the resolution at the top
+// of the range is 2^-32 cycles). The kernels only use the fractional part;
+// the long period keeps composite partials with non-integer ratios, which
+// CompositeWave quantizes to multiples of 1 / PHASE_PERIOD, continuous
+// across the wrap. Each sample advances the
+// accumulator by frequency / sample_rate; changing the frequency only
+// changes the increment, so the output stays continuous. Noise comes from
+// the oscillator's own generator, so equal seeds give equal output.
+class Oscillator {
+ public:
+  static constexpr double PHASE_PERIOD = 1 << CompositeWave::RATIO_BITS;
+
+  explicit Oscillator(uint64_t seed = NoiseGenerator::DEFAULT_SEED)
+      : noise_(seed) {}
+
+  // Fill `out` with the next n samples at `sample_rate` samples per second
+  void GenerateBlock(const WaveParams& params, double sample_rate, float* out,
+                     size_t n);
+
+  // The same for an accumulator and noise generator held elsewhere, e.g.
+  // one channel of an OscillatorBank. `phase` is advanced and wrapped like
+  // the member one.
+  static void Generate(const WaveParams& params, double sample_rate,
+                       double& phase, NoiseGenerator& noise, float* out,
+                       size_t n);
+
+  // Generate() with the parameters modulated sample by sample. The phase
+  // advances by the modulated increment, so FM stays continuous and may
+  // run through zero. The naive shapes are used in every generation mode,
+  // since the band-limited paths assume a constant increment. Composite
+  // waves follow FM and PM per 16-sample chunk, at the phase and mean
+  // increment of each chunk. Noise is added after the amplitude
+  // modulation.
+  static void GenerateModulated(const WaveParams& params, double sample_rate,
+                                double& phase, NoiseGenerator& noise,
+                                const ModulationInput& modulation, float* out,
+                                size_t n);
+
+  // Block kernel that generates `type` in `mode`. Composite waves are
+  // rendered by their CompositeWave; their kernel is the fundamental.
+  static WaveKernels::KernelFn SelectKernel(WaveType type, GenerationMode mode);
+
+  // Restart at the given phase (in cycles), wrapped to [0, PHASE_PERIOD)
+  void Reset(double phase = 0.0);
+
+  // Restart the noise sequence
+  void Seed(uint64_t seed) { noise_.Seed(seed); }
+
+  // Current accumulator value in cycles, in [0, PHASE_PERIOD)
+  double GetPhase() const { return phase_; }
+
+ private:
+  double phase_ = 0.0;
+  NoiseGenerator noise_;
+};
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ModulationMatrix.hpp"
+#include "Oscillator.hpp"
+
+class ThreadPool;
+
+// Many independent oscillators, stored as a structure of arrays.
+//
+// Each parameter lives in its own contiguous array indexed by channel, and
+// so do the double-precision phase accumulators, so sweeping one parameter
+// over all channels touches only that array. A channel is generated with
+// the same block kernels as a single Oscillator; GenerateBlock() spreads
+// the channels over a ThreadPool. Every channel has its own noise stream,
+// derived from the bank seed and the channel index, so the output does not
+// depend on which worker generated a channel. Channels can modulate each
+// other through the bank's ModulationMatrix.
+class OscillatorBank {
+ public:
+  static constexpr size_t MAX_CHANNELS = 1024;
+
+  // Parameters a channel starts with: the wave types in turn and a
+  // frequency that grows with the index, so channels are told apart
+  static WaveParams DefaultChannel(size_t index);
+
+  // Grow or shrink to `count` channels (at most MAX_CHANNELS). Existing
+  // channels keep their parameters and phase.
+  void Resize(size_t count);
+  size_t GetChannelCount() const { return wave_types_.size(); }
+
+  WaveParams GetChannel(size_t channel) const;
+  void SetChannel(size_t channel, const WaveParams& params);
+
+  // Restart every accumulator at phase 0
+  void ResetPhases();
+
+  // Restart every channel's noise sequence from `seed`
+  void SetSeed(uint64_t seed);
+  uint64_t GetSeed() const { return seed_; }
+
+  // Routes between the channels, applied by GenerateBlock()
+  ModulationMatrix& GetModulation() { return modulation_; }
+  const ModulationMatrix& GetModulation() const { return modulation_; }
+
+  // Next n samples of one channel at `sample_rate` samples per second,
+  // without modulation
+  void GenerateChannel(size_t channel, double sample_rate, float* out,
+                       size_t n);
+
+  // Next n samples of every channel; channel c is written to
+  // out[c * stride, c * stride + n). Runs on the caller without a pool.
+  // With modulation routes, modulated sources lag by one block, so the
+  // output depends on how a run is cut into blocks.
+  void GenerateBlock(double sample_rate, float* out, size_t n, size_t stride,
+                     ThreadPool* pool);
+
+  // Channels handed to one pool task, so a task has roughly
+  // TASK_SAMPLES samples of work
+  static size_t TaskGrain(size_t samples_per_channel);
+
+ private:
+  static constexpr size_t TASK_SAMPLES = 16384;
+
+  // Rebuild the evaluation plan below from the matrix
+  void PlanModulation();
+  // Stage two of GenerateBlock(): one modulated destination, with routes
+  // active_routes_[first, last)
+  void GenerateModulated(size_t first, size_t last, double sample_rate,
+                         float* out, size_t n, size_t stride);
+
+  std::vector<WaveType> wave_types_;
+  std::vector<float> frequencies_;
+  std::vector<float> amplitudes_;
+  std::vector<float> phases_;  // Offsets in radians
+  std::vector<float> noises_;
+  std::vector<NoiseType> noise_types_;
+  std::vector<GenerationMode> generation_modes_;
+  std::vector<CompositeWavePtr> composites_;
+  std::vector<double> accumulators_;  // Running phase in cycles
+  std::vector<NoiseGenerator> noise_generators_;
+  uint64_t seed_ = NoiseGenerator::DEFAULT_SEED;
+
+  ModulationMatrix modulation_;
+  // Evaluation plan, rebuilt by every GenerateBlock()
+  std::vector<ModRoute> active_routes_;  // Valid routes by destination
+  std::vector<size_t> destinations_;     // First route of each destination
+  std::vector<uint8_t> modulated_;       // Per channel
+  std::vector<size_t> free_channels_;    // Channels without routes
+  std::vector<size_t> delayed_sources_;  // Modulated channels used as source
+  std::vector<std::vector<float>> previous_;  // Last block, per channel
+};
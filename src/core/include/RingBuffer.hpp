@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+// Fixed-capacity circular sample store.
+//
+// Push() is O(1): once the buffer is full the oldest element is overwritten
+// instead of shifting the whole history. The retained samples are exposed as
+// (at most) two contiguous segments, oldest first, so readers can iterate the
+// history without copying it. The buffer has a single writer and takes no
+// locks; cross-thread hand-off is done by the caller.
+template <typename T>
+class RingBuffer {
+ public:
+  explicit RingBuffer(size_t capacity = 0) { Reset(capacity); }
+
+  // Reallocate storage for `capacity` elements and drop all samples.
+  void Reset(size_t capacity) {
+    capacity_ = capacity;
+    data_ = capacity_ > 0 ? std::make_unique<T[]>(capacity_) : nullptr;
+    Clear();
+  }
+
+  void Clear() {
+    head_ = 0;
+    size_ = 0;
+  }
+
+  void Push(const T& value) {
+    if (capacity_ == 0) return;
+    data_[head_] = value;
+    head_ = head_ + 1 == capacity_ ? 0 : head_ + 1;
+    if (size_ < capacity_) ++size_;
+    ++total_pushed_;
+  }
+
+  void Push(const T* values, size_t count) {
+    for (size_t i = 0; i < count; ++i) Push(values[i]);
+  }
+
+  size_t Size() const { return size_; }
+  size_t Capacity() const { return capacity_; }
+  bool Empty() const { return size_ == 0; }
+  bool Full() const { return size_ == capacity_; }
+
+  // Number of samples ever pushed; the absolute index of the oldest retained
+  // sample is TotalPushed() - Size().
+  uint64_t TotalPushed() const { return total_pushed_; }
+
+  // Oldest and newest retained samples. Undefined when empty.
+  const T& Front() const { return data_[Tail()]; }
+  const T& Back() const {
+    return data_[head_ == 0 ? capacity_ - 1 : head_ - 1];
+  }
+
+  // i = 0 is the oldest retained sample.
+  const T& operator[](size_t i) const {
+    size_t index = Tail() + i;
+    if (index >= capacity_) index -= capacity_;
+    return data_[index];
+  }
+
+  // Oldest run of samples, up to the physical end of the storage.
+  std::span<const T> FirstSegment() const {
+    size_t tail = Tail();
+    size_t length = tail + size_ <= capacity_ ? size_ : capacity_ - tail;
+    return {data_.get() + tail, length};
+  }
+
+  // Remaining (newest) samples that wrapped to the start of the storage.
+  std::span<const T> SecondSegment() const {
+    return {data_.get(), size_ - FirstSegment().size()};
+  }
+
+ private:
+  size_t Tail() const {
+    return head_ >= size_ ? head_ - size_ : head_ + capacity_ - size_;
+  }
+
+  std::unique_ptr<T[]> data_;
+  size_t capacity_ = 0;
+  size_t head_ = 0;  // Next write position
+  size_t size_ = 0;
+  uint64_t total_pushed_ = 0;
+};
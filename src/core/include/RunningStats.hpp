@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+// Statistics of a sliding window of samples, maintained incrementally.
+//
+// Samples enter with Push() and leave, oldest first, with Pop(). Min and max
+// come from monotonic deques (amortized O(1) per sample); mean, variance and
+// RMS from Neumaier-compensated running sums, so adding and removing
+// millions of samples does not accumulate rounding drift. Every query is
+// O(1) regardless of the window length.
+class RunningStats {
+ public:
+  void Reset();
+
+  // Add the newest sample
+  void Push(float value);
+  // Remove the oldest sample; `value` must be the one pushed first
+  void Pop(float value);
+
+  size_t GetCount() const { return count_; }
+  bool Empty() const { return count_ == 0; }
+
+  // All queries return 0 for an empty window
+  float GetMin() const { return min_.empty() ? 0.f : min_.front().value; }
+  float GetMax() const { return max_.empty() ? 0.f : max_.front().value; }
+  double GetMean() const;
+  double GetVariance() const;  // Population variance
+  double GetStdDev() const;
+  double GetRms() const;
+
+ private:
+  // Neumaier (improved Kahan) summation supporting removal
+  struct CompensatedSum {
+    double sum = 0.0;
+    double compensation = 0.0;
+
+    void Add(double value);
+    double Get() const { return sum + compensation; }
+  };
+
+  struct Entry {
+    uint64_t index;
+    float value;
+  };
+
+  std::deque<Entry> min_;  // Increasing values, front is the window minimum
+  std::deque<Entry> max_;  // Decreasing values, front is the window maximum
+  uint64_t pushed_ = 0;
+  uint64_t popped_ = 0;
+  size_t count_ = 0;
+
+  // Sums are taken around `shift_` (the first sample after a reset) so the
+  // variance does not cancel catastrophically for signals with a DC offset
+  double shift_ = 0.0;
+  CompensatedSum sum_;
+  CompensatedSum sum_squares_;
+};
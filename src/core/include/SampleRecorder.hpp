@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SampleSink.hpp"
+#include "SpscQueue.hpp"
+
+// Streams samples to a file from a background writer thread.
+//
+// OnSamples() only copies into a bounded lock-free queue, so the frame loop
+// never waits on the disk; if the writer falls so far behind that the queue
+// fills up, the excess samples are counted as dropped instead of growing
+// memory. The writer formats into a block buffer and issues one fwrite per
+// WRITE_BLOCK bytes, or for a partial block that has waited
+// FLUSH_INTERVAL_MS, so slow recordings still reach the file. Subclasses define the file format. Builds without
+// threads (Emscripten) format and write synchronously.
+//
+// Samples count as written once the block holding them reached the file.
+// A failed write (e.g. a full disk) marks the recording as failed: the
+// recorder then discards everything it receives instead of counting it as
+// written, and keeps the failure until the next Start().
+//
+// A recording has one sample rate, given to Start(); the owner stops it
+// when the rate of the incoming samples changes.
+//
+// Subclass destructors must call Stop(): the writer thread calls the
+// formatting hooks, which are gone once the subclass is destroyed.
+class SampleRecorder : public SampleSink {
+ public:
+  static constexpr size_t QUEUE_CAPACITY = 1 << 22;  // 16 MB of samples
+  static constexpr size_t WRITE_BLOCK = 1 << 20;     // Bytes per fwrite
+  static constexpr int FLUSH_INTERVAL_MS = 1000;
+
+  SampleRecorder();
+  ~SampleRecorder() override = default;
+
+  SampleRecorder(const SampleRecorder&) = delete;
+  SampleRecorder& operator=(const SampleRecorder&) = delete;
+
+  // Open `path` and start recording samples taken at `sample_rate`. Returns
+  // false if already recording or the file cannot be created.
+  bool Start(const std::string& path, double sample_rate);
+  // Write out everything queued, finish the file and close it. Returns
+  // false if any write, finishing or closing the file failed.
+  bool Stop();
+  bool IsRecording() const { return file_ != nullptr; }
+
+  void OnSamples(const float* values, size_t count,
+                 uint64_t first_index) override;
+
+  const std::string& GetPath() const { return path_; }
+  double GetSampleRate() const { return sample_rate_; }
+  uint64_t GetWrittenSamples() const { return written_.load(); }
+  uint64_t GetWrittenBytes() const { return bytes_.load(); }
+  uint64_t GetDroppedSamples() const { return dropped_.load(); }
+  // Whether a write failed; GetError() is its errno value
+  bool HasFailed() const { return error_.load() != 0; }
+  int GetError() const { return error_.load(); }
+
+ protected:
+  // Formatting hooks, called on the writer thread. `index` counts samples
+  // from the start of the recording.
+  virtual void FormatHeader(std::vector<char>& out) = 0;
+  virtual void FormatSamples(const float* values, size_t count,
+                             uint64_t index, std::vector<char>& out) = 0;
+  // Called after the last block was written, e.g. to patch a header.
+  // Returns false if that failed.
+  virtual bool Finish(std::FILE* file) {
+    (void)file;
+    return true;
+  }
+
+ private:
+  void ThreadMain();
+  // Format everything queued; writes whenever a block fills up
+  void DrainQueue();
+  void Flush();
+  // Flush a partial block once FLUSH_INTERVAL_MS passed since the last
+  // write
+  void FlushIfDue();
+  // Record the first failure, with errno as the cause
+  void Fail();
+
+  SpscQueue<float> queue_;
+  std::FILE* file_ = nullptr;
+  std::string path_;
+  double sample_rate_ = 0.0;
+  std::vector<char> block_;
+  uint64_t next_index_ = 0;  // Writer thread
+  uint64_t pending_ = 0;     // Formatted samples not yet written
+  std::chrono::steady_clock::time_point last_flush_;
+
+  std::atomic<uint64_t> written_{0};
+  std::atomic<uint64_t> bytes_{0};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<int> error_{0};
+
+#ifndef __EMSCRIPTEN__
+  std::thread thread_;
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::atomic<bool> stop_{false};
+#endif
+};
+
+// CSV rows of "index,time_s,value" for samples starting at `index`
+void FormatCsvRows(const float* values, size_t count, uint64_t index,
+                   double sample_rate, std::vector<char>& out);
+constexpr const char* CSV_HEADER = "index,time_s,value\n";
+
+// Records samples as CSV rows of "index,time_s,value"
+class CsvRecorder : public SampleRecorder {
+ public:
+  ~CsvRecorder() override { Stop(); }
+
+ protected:
+  void FormatHeader(std::vector<char>& out) override;
+  void FormatSamples(const float* values, size_t count, uint64_t index,
+                     std::vector<char>& out) override;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Receives every sample appended to the CoreLogic history, in order, on the
+// thread that appends them. Implementations must return quickly: they run
+// inside the frame loop.
+class SampleSink {
+ public:
+  virtual ~SampleSink() = default;
+
+  // `first_index` is the absolute index of values[0] since startup
+  virtual void OnSamples(const float* values, size_t count,
+                         uint64_t first_index) = 0;
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Non-owning, read-only view of the sample history.
+//
+// The history lives in a ring buffer, so it is exposed as two contiguous
+// segments (oldest first). The view is only valid until the next write to
+// the history. `version` changes whenever the history changes, so consumers
+// can cache derived data and skip work when nothing new has arrived.
+struct SampleView {
+  std::span<const float> first;
+  std::span<const float> second;
+  uint64_t version = 0;
+
+  size_t size() const { return first.size() + second.size(); }
+  bool empty() const { return size() == 0; }
+
+  // i = 0 is the oldest sample
+  float operator[](size_t i) const {
+    return i < first.size() ? first[i] : second[i - first.size()];
+  }
+
+  float back() const { return second.empty() ? first.back() : second.back(); }
+
+  template <typename Fn>
+  void ForEach(Fn&& fn) const {
+    for (float v : first) fn(v);
+    for (float v : second) fn(v);
+  }
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "Oscillator.hpp"
+#include "SpscQueue.hpp"
+
+class CoreLogic;
+
+// Converts elapsed wall time into a whole number of due samples at a fixed
+// sample rate. Time is anchored at Start(), so rounding never accumulates.
+class SampleClock {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  void Start(double sample_rate, Clock::time_point now);
+
+  // Samples that became due since the last call. If more than `max_backlog`
+  // are due (the caller fell behind), the excess is skipped instead of being
+  // generated in one burst.
+  size_t Advance(Clock::time_point now, size_t max_backlog);
+
+  double GetRate() const { return rate_; }
+  uint64_t GetSkipped() const { return skipped_; }
+
+ private:
+  double rate_ = 0.0;
+  Clock::time_point start_;
+  uint64_t emitted_ = 0;
+  uint64_t skipped_ = 0;
+};
+
+// Runs the oscillator on its own thread at a true sample rate.
+//
+// The thread wakes on a fixed 1 ms tick, generates every sample that became
+// due since the previous tick and publishes them through a lock-free SPSC
+// queue. The UI thread moves them into the CoreLogic history with Drain()
+// once per frame, so a slow frame only delays delivery; samples are never
+// dropped or bunched as long as the queue has room. Parameter changes travel
+// the other way through a second SPSC queue.
+class Simulation {
+ public:
+  static constexpr size_t DEFAULT_QUEUE_CAPACITY = 1 << 21;  // ~2 s at 1 MHz
+  static constexpr double MIN_SAMPLE_RATE = 1.0;
+  static constexpr double MAX_SAMPLE_RATE = 1e6;
+
+  explicit Simulation(size_t queue_capacity = DEFAULT_QUEUE_CAPACITY);
+  ~Simulation();
+
+  Simulation(const Simulation&) = delete;
+  Simulation& operator=(const Simulation&) = delete;
+
+  void Start(const WaveParams& params, double sample_rate);
+  void Stop();
+  bool IsRunning() const { return running_.load(); }
+
+  // UI thread: publish parameters; only changes are forwarded
+  void SetParameters(const WaveParams& params, double sample_rate);
+  // UI thread: restart the noise sequence from `seed`
+  void Reseed(uint64_t seed);
+  void SetPaused(bool paused);
+
+  // UI thread: move all pending samples into the history
+  size_t Drain(CoreLogic& core);
+
+  // Samples per second delivered to the UI, averaged over ~0.5 s
+  double GetMeasuredRate() const { return measured_rate_; }
+  uint64_t GetGeneratedSamples() const { return generated_.load(); }
+  // Samples lost because the queue was full or the thread fell behind
+  uint64_t GetDroppedSamples() const { return dropped_.load(); }
+
+ private:
+  struct Settings {
+    WaveParams params;
+    double sample_rate = 60.0;
+    uint64_t seed = NoiseGenerator::DEFAULT_SEED;
+    uint64_t reseeds = 0;  // Bumped by each Reseed(), even to the same seed
+
+    bool operator==(const Settings&) const = default;
+  };
+
+  void ThreadMain(Settings settings);
+  // Forward `wanted_` unless the thread already has it
+  void Publish();
+
+  SpscQueue<float> samples_;
+  SpscQueue<Settings> settings_;
+  Settings wanted_;
+  Settings published_;
+
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+  std::atomic<bool> paused_{false};
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+
+  std::atomic<uint64_t> generated_{0};
+  std::atomic<uint64_t> dropped_{0};
+
+  // Delivery rate bookkeeping (UI thread)
+  SampleClock::Clock::time_point rate_window_start_;
+  uint64_t rate_window_samples_ = 0;
+  double measured_rate_ = 0.0;
+};
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <complex>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Fft.hpp"
+#include "SampleView.hpp"
+
+enum class FftWindow { RECTANGULAR = 0, HANN, BLACKMAN_HARRIS };
+
+struct SpectrumResult {
+  // size / 2 + 1 bins from DC to Nyquist, in dB relative to a unit-amplitude
+  // sine (a sine of amplitude A peaks at 20 log10(A))
+  std::vector<float> magnitude_db;
+  size_t size = 0;
+  double sample_rate = 0.0;
+  double compute_ms = 0.0;  // Windowing, transform and magnitude
+  uint64_t version = 0;     // History version the spectrum was taken from
+
+  double BinFrequency(size_t bin) const { return bin * sample_rate / size; }
+};
+
+// Computes magnitude spectra of the sample history off the UI thread.
+//
+// The UI thread submits the newest samples once per frame and picks up the
+// finished spectrum on a later frame. Only one request is in flight: while
+// the worker is busy, Submit() declines, so a slow transform lowers the
+// spectrum update rate instead of queueing work. Builds without threads
+// (Emscripten) compute synchronously inside Submit().
+class SpectrumAnalyzer {
+ public:
+  static constexpr size_t MIN_SIZE = 64;
+  static constexpr size_t MAX_SIZE = 65536;
+  static constexpr float FLOOR_DB = -160.f;
+
+  SpectrumAnalyzer();
+  ~SpectrumAnalyzer();
+
+  SpectrumAnalyzer(const SpectrumAnalyzer&) = delete;
+  SpectrumAnalyzer& operator=(const SpectrumAnalyzer&) = delete;
+
+  // Analyze the newest `size` samples of `history`; shorter histories are
+  // zero-padded. Returns false if the previous request is still running.
+  bool Submit(const SampleView& history, size_t size, FftWindow window,
+              double sample_rate);
+
+  // Swap the newest finished spectrum into `out`; false if none is new
+  bool Fetch(SpectrumResult& out);
+
+ private:
+  struct Request {
+    std::vector<float> samples;  // Newest samples, oldest first
+    size_t size = 0;
+    FftWindow window = FftWindow::HANN;
+    double sample_rate = 0.0;
+    uint64_t version = 0;
+  };
+
+  void ThreadMain();
+  void Compute(const Request& request, SpectrumResult& result);
+
+  // Worker-owned state, reused between requests
+  RealFft fft_;
+  std::vector<float> window_;
+  FftWindow window_type_ = FftWindow::RECTANGULAR;
+  size_t window_length_ = 0;
+  float window_gain_ = 1.f;
+  std::vector<float> input_;
+  std::vector<std::complex<float>> bins_;
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  Request pending_;
+  Request active_;
+  SpectrumResult latest_;
+  bool has_request_ = false;
+  bool busy_ = false;
+  bool has_result_ = false;
+  bool stop_ = false;
+#ifndef __EMSCRIPTEN__
+  std::thread thread_;
+#endif
+};
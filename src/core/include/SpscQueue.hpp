@@ -0,0 +1,75 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+// Bounded lock-free single-producer/single-consumer queue.
+//
+// One thread may call the Push* methods and one other thread the Pop* /
+// Consume methods. The capacity is rounded up to a power of two. Producers
+// never block: when the queue is full, Push() writes what fits and reports
+// how many elements were accepted.
+template <typename T>
+class SpscQueue {
+ public:
+  explicit SpscQueue(size_t capacity) {
+    size_t rounded = 1;
+    while (rounded < capacity) rounded <<= 1;
+    data_ = std::make_unique<T[]>(rounded);
+    mask_ = rounded - 1;
+  }
+
+  size_t Capacity() const { return mask_ + 1; }
+
+  // Approximate number of queued elements (exact on the consumer thread)
+  size_t SizeApprox() const {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+
+  // Producer: append up to `count` elements, returns how many were written
+  size_t Push(const T* values, size_t count) {
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    count = std::min(count, Capacity() - (head - tail));
+    for (size_t i = 0; i < count; ++i) data_[(head + i) & mask_] = values[i];
+    head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  bool Push(const T& value) { return Push(&value, 1) == 1; }
+
+  // Consumer: hand up to `max_count` queued elements to fn(const T*, size_t)
+  // as at most two contiguous runs, then release them. Returns the number of
+  // elements consumed.
+  template <typename Fn>
+  size_t Consume(size_t max_count, Fn&& fn) {
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t count = std::min(max_count, head - tail);
+    if (count == 0) return 0;
+    const size_t start = tail & mask_;
+    const size_t first = std::min(count, Capacity() - start);
+    fn(&data_[start], first);
+    if (first < count) fn(&data_[0], count - first);
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  size_t Pop(T* out, size_t max_count) {
+    return Consume(max_count, [&out](const T* values, size_t n) {
+      out = std::copy(values, values + n, out);
+    });
+  }
+
+  bool Pop(T& out) { return Pop(&out, 1) == 1; }
+
+ private:
+  std::unique_ptr<T[]> data_;
+  size_t mask_ = 0;
+  // Kept on separate cache lines so producer and consumer don't false-share
+  alignas(64) std::atomic<size_t> head_{0};  // Written by the producer
+  alignas(64) std::atomic<size_t> tail_{0};  // Written by the consumer
+};
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads with work stealing.
+//
+// ParallelFor() cuts a range into tasks and deals them round-robin onto
+// per-worker deques. Each worker takes tasks from the back of its own deque
+// and, once that is empty, steals from the front of the others, so uneven
+// tasks (e.g. noisy and noise-free channels) even out without a shared
+// queue that every thread contends on. The calling thread works along and
+// returns when every task of the range has finished.
+//
+// Only one thread may call ParallelFor() at a time. With zero workers (and
+// always in the single-threaded web build) the range runs on the caller.
+class ThreadPool {
+ public:
+  using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+  // One worker per hardware thread besides the caller
+  static size_t DefaultWorkerCount();
+
+  explicit ThreadPool(size_t worker_count = DefaultWorkerCount());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Run fn(begin, end) over [0, count) in tasks of at most `grain` items
+  void ParallelFor(size_t count, size_t grain, const RangeFn& fn);
+
+  size_t GetWorkerCount() const { return threads_.size(); }
+  // Tasks taken from another thread's deque since startup
+  uint64_t GetStolenTasks() const { return stolen_.load(); }
+
+ private:
+  struct Task {
+    const RangeFn* fn = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+    std::atomic<size_t>* remaining = nullptr;
+  };
+
+  // Kept on separate cache lines so owners and thieves don't false-share
+  struct alignas(64) TaskDeque {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void WorkerMain(size_t index);
+  bool PopLocal(size_t index, Task& task);
+  bool Steal(size_t thief, Task& task);
+  void Execute(const Task& task);
+
+  // One deque per worker, plus the last one for the calling thread
+  std::vector<std::unique_ptr<TaskDeque>> deques_;
+  std::vector<std::thread> threads_;
+
+  std::mutex wake_mutex_;
+  std::condition_variable wake_;
+  std::atomic<size_t> queued_{0};  // Tasks waiting in any deque
+  bool stopping_ = false;
+
+  std::atomic<uint64_t> stolen_{0};
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+// Low-overhead tracing with Chrome trace_event JSON export.
+//
+// TRACE_SCOPE("Name") records the enclosing block as one complete ("X")
+// event. When tracing is disabled a scope costs one relaxed atomic load and
+// one predictable branch. When enabled, each thread appends to its own
+// fixed-size buffer without locks; once a buffer is full further events of
+// that thread are counted as dropped. Names must be string literals (or
+// otherwise outlive the trace). Load a written file in chrome://tracing or
+// https://ui.perfetto.dev.
+namespace Trace {
+
+using Clock = std::chrono::steady_clock;
+
+// Events per thread buffer
+constexpr size_t BUFFER_EVENTS = 1 << 17;
+
+namespace detail {
+inline std::atomic<bool> enabled{false};
+void Record(const char* name, Clock::time_point start, Clock::time_point end);
+}  // namespace detail
+
+inline bool IsEnabled() {
+  return detail::enabled.load(std::memory_order_relaxed);
+}
+
+// Discard previous events and start recording
+void Start();
+void Stop();
+
+// Name the calling thread in the trace viewer
+void SetThreadName(const char* name);
+
+// Write every recorded event as Chrome trace JSON; safe while recording
+bool WriteJson(const std::string& path);
+
+uint64_t GetEventCount();
+uint64_t GetDroppedEvents();
+
+class Scope {
+ public:
+  explicit Scope(const char* name) {
+    if (IsEnabled()) {
+      name_ = name;
+      start_ = Clock::now();
+    }
+  }
+  ~Scope() {
+    if (name_) detail::Record(name_, start_, Clock::now());
+  }
+
+  Scope(const Scope&) = delete;
+  Scope& operator=(const Scope&) = delete;
+
+ private:
+  const char* name_ = nullptr;
+  Clock::time_point start_;
+};
+
+}  // namespace Trace
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name) \
+  ::Trace::Scope TRACE_CONCAT(trace_scope_, __LINE__)(name)
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "Oscillator.hpp"
+#include "SampleRecorder.hpp"
+
+enum class WavFormat { PCM16 = 0, PCM24, FLOAT32 };
+
+// Encoding helpers for mono RIFF/WAVE files.
+//
+// Samples are divided by `full_scale` so that +-full_scale maps to the
+// format's full range; PCM output is clipped at full scale.
+namespace Wav {
+
+constexpr size_t HEADER_SIZE = 44;
+
+size_t BytesPerSample(WavFormat format);
+
+// Append a canonical 44-byte header for `frames` samples
+void EncodeHeader(WavFormat format, uint32_t sample_rate, uint64_t frames,
+                  std::vector<char>& out);
+
+// Append n little-endian samples
+void EncodeSamples(WavFormat format, const float* values, size_t n,
+                   float full_scale, std::vector<char>& out);
+
+// Rewrite the header of an open file once the sample count is known
+bool PatchHeader(std::FILE* file, WavFormat format, uint32_t sample_rate,
+                 uint64_t frames);
+
+}  // namespace Wav
+
+// Writes a WAV file synchronously, in blocks. Once a write fails, later
+// ones are skipped and Close() reports the failure; the header then
+// describes the frames that were written in full.
+class WavWriter {
+ public:
+  ~WavWriter() { Close(); }
+
+  bool Open(const std::string& path, WavFormat format, uint32_t sample_rate,
+            float full_scale);
+  // False if this or an earlier write failed
+  bool Write(const float* values, size_t n);
+  // Patch the header with the final length and close the file. Returns
+  // false if any write, the header patch or closing failed.
+  bool Close();
+
+  uint64_t GetFrames() const { return frames_; }
+
+ private:
+  std::FILE* file_ = nullptr;
+  WavFormat format_ = WavFormat::PCM16;
+  uint32_t sample_rate_ = 0;
+  float full_scale_ = 1.f;
+  uint64_t frames_ = 0;  // Written in full
+  bool failed_ = false;
+  std::vector<char> block_;
+};
+
+struct WavRenderStats {
+  uint64_t frames = 0;
+  double seconds = 0.0;             // Wall time including disk writes
+  double samples_per_second = 0.0;  // frames / seconds
+};
+
+// Offline render: write `duration` seconds of `params` to `path` as fast as
+// the CPU allows, using batch oscillator generation. Full scale is the peak
+// level the parameters can reach (amplitude plus noise). `progress`, if
+// given, counts the frames written so far, for a render on another thread.
+bool RenderWavFile(const std::string& path, const WaveParams& params,
+                   uint32_t sample_rate, double duration, WavFormat format,
+                   WavRenderStats* stats = nullptr,
+                   uint64_t seed = NoiseGenerator::DEFAULT_SEED,
+                   std::atomic<uint64_t>* progress = nullptr);
+
+// Live WAV recording through the background SampleRecorder writer.
+// Configure the encoding with SetFormat() before Start().
+class WavRecorder : public SampleRecorder {
+ public:
+  ~WavRecorder() override { Stop(); }
+
+  void SetFormat(WavFormat format, float full_scale) {
+    format_ = format;
+    full_scale_ = full_scale;
+  }
+
+ protected:
+  void FormatHeader(std::vector<char>& out) override;
+  void FormatSamples(const float* values, size_t count, uint64_t index,
+                     std::vector<char>& out) override;
+  bool Finish(std::FILE* file) override;
+
+ private:
+  uint32_t GetIntegerRate() const;
+
+  WavFormat format_ = WavFormat::PCM16;
+  float full_scale_ = 1.f;
+};
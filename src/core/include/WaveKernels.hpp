@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+
+#include "WaveType.hpp"
+
+// Vectorized waveform kernels.
+//
+// Every kernel writes n samples of a unit waveform scaled by `amplitude`.
+// Phase is measured in cycles: sample i is taken at phase + i * increment,
+// so 0.25 is a quarter period. Only the fractional parts of phase and
+// increment matter.
+//
+// Sine and cosine use an odd degree-11 polynomial on the quarter wave
+// (|x| <= pi/2) instead of std::sin. The truncation error of that series is
+// below 6e-8 and the polynomial evaluated in float stays within 2.5e-7 of
+// sin(). Lanes carry their phase in float, which adds up to 6e-8 cycles of
+// phase error; the measured maximum absolute error against double-precision
+// std::sin at the exact phase is 7.3e-7 on every ISA, bounded by
+// SINE_MAX_ERROR. Square, triangle and sawtooth are exact piecewise-linear
+// functions of the phase. All ISAs share the same algorithm, so they agree
+// to within float rounding. WaveType::COMPOSITE has no fixed shape; its
+// kernels generate the fundamental alone (see CompositeWave).
+namespace WaveKernels {
+
+enum class Isa { SCALAR = 0, SSE2, AVX2 };
+
+using KernelFn = void (*)(float* out, size_t n, double phase,
+                          double increment, float amplitude);
+
+// Maximum absolute error of the sine/cosine kernels at unit amplitude
+constexpr float SINE_MAX_ERROR = 1e-6f;
+
+// Best ISA supported by this CPU, detected once at startup
+Isa ActiveIsa();
+const char* IsaName(Isa isa);
+bool IsSupported(Isa isa);
+
+// Kernel for the active ISA
+KernelFn Get(WaveType type);
+// Kernel for a specific ISA; falls back to scalar when unsupported
+KernelFn Get(WaveType type, Isa isa);
+
+// Band-limited kernel for the active ISA (see GenerationMode). Square,
+// triangle and sawtooth run the naive kernel and then recompute the samples
+// within one sample of each discontinuity with a PolyBLEP (steps) or
+// PolyBLAMP (corners) residual, so the cost over the naive kernel is a few
+// operations per discontinuity rather than per sample. Sine and cosine have
+// no discontinuities and use the plain kernels. Increments above half a
+// cycle per sample are left naive.
+KernelFn GetBandLimited(WaveType type);
+// Band-limited kernel on top of a specific ISA's naive kernel
+KernelFn GetBandLimited(WaveType type, Isa isa);
+
+}  // namespace WaveKernels
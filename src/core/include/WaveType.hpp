@@ -0,0 +1,22 @@
+#pragma once
+
+enum class WaveType {
+  SINE = 0,
+  COSINE,
+  SQUARE,
+  TRIANGLE,
+  SAWTOOTH,
+  COMPOSITE  // Sum of user-defined partials, see CompositeWave.hpp
+};
+
+// How the waveforms are generated. NAIVE samples the ideal shape and
+// aliases at high frequencies; POLYBLEP smooths each jump (and each corner
+// of the triangle) with a two-sample polynomial residual. The WAVETABLE
+// modes read precomputed band-limited tables (see Wavetable.hpp) with
+// linear or cubic interpolation.
+enum class GenerationMode {
+  NAIVE = 0,
+  POLYBLEP,
+  WAVETABLE_LINEAR,
+  WAVETABLE_CUBIC
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+
+#include "WaveKernels.hpp"
+#include "WaveType.hpp"
+
+// Mip-mapped wavetables for the GenerationMode::WAVETABLE_* modes.
+//
+// Every wave type is stored as LEVELS single-cycle tables of TABLE_SIZE
+// samples. Level k is the Fourier series of the shape truncated to
+// MAX_HARMONICS >> k harmonics, summed in double precision, so each table
+// is band-limited and at least twice oversampled. Playback picks the
+// richest level whose top harmonic stays below Nyquist at the current
+// increment, then reads it with linear or 4-point cubic (Catmull-Rom)
+// interpolation: a table lookup per sample, independent of the shape.
+//
+// The tables are built on first use (a few milliseconds) and are read-only
+// afterwards, so any number of oscillators and threads can share them.
+// Prepare() builds them ahead of time, e.g. before the first frame.
+namespace Wavetable {
+
+constexpr size_t TABLE_SIZE = 2048;
+constexpr size_t MAX_HARMONICS = TABLE_SIZE / 4;
+constexpr size_t LEVELS = 10;  // MAX_HARMONICS down to 1 harmonic
+
+// Largest magnitude of a unit-amplitude table. Truncated series overshoot
+// the ideal shape; the worst case is the square's bare fundamental, 4 / pi.
+constexpr float PEAK = 1.28f;
+
+void Prepare();
+
+// Level for `increment` cycles per sample, in [0, LEVELS)
+size_t SelectLevel(double increment);
+
+// Harmonics kept at `level`
+inline size_t HarmonicCount(size_t level) { return MAX_HARMONICS >> level; }
+
+// TABLE_SIZE samples of one cycle, with one guard sample before and two
+// after, i.e. table[-1] through table[TABLE_SIZE + 1] are valid
+const float* GetTable(WaveType type, size_t level);
+
+// Kernel with the WaveKernels signature that plays the tables of `type`
+WaveKernels::KernelFn GetKernel(WaveType type, bool cubic);
+
+}  // namespace Wavetable
@@ -0,0 +1,4 @@
+#include "Headless.hpp"
+
+// Display-less build of the simulator: links core_logic only
+int main(int argc, char* argv[]) { return RunHeadless(argc, argv); }
@@ -1,5 +1,9 @@
 #include "CoreLogic.hpp"
 #include "Gui.hpp"
+#include "Headless.hpp"
+#include "Simulation.hpp"
+#include "Trace.hpp"
+#include "Wavetable.hpp"
 #ifdef __EMSCRIPTEN__
 
 #include <emscripten.h>
@@ -8,6 +12,7 @@
 struct EmscriptenLoopArgs {
   Gui* gui;
   CoreLogic* coreLogic;
+  SampleClock clock;
 };
 
 void emscripten_loop(void* arg) {
@@ -17,14 +22,29 @@ void emscripten_loop(void* arg) {
 
   gui->ProcessEvents();
 
-  if (!gui->IsPaused()) {
-    coreLogic->Update();
+  // No threads in the web build: generate the samples due this frame
+  auto now = SampleClock::Clock::now();
+  double rate = coreLogic->GetFps();
+  if (gui->IsPaused() || args->clock.GetRate() != rate) {
+    args->clock.Start(rate, now);
+  } else {
+    FrameProfiler::Scope scope(gui->GetProfiler(), FramePhase::SIMULATION);
+    coreLogic->Advance(args->clock.Advance(now, static_cast<size_t>(rate)));
   }
   gui->Run();
 }
 #endif
 
 int main(int argc, char* argv[]) {
+#ifndef __EMSCRIPTEN__
+  // Batch generation: no window, no ImGui context
+  if (IsHeadlessRequested(argc, argv)) {
+    return RunHeadless(argc, argv);
+  }
+#endif
+
+  // Build the wavetables now rather than when the mode is first selected
+  Wavetable::Prepare();
 
   CoreLogic coreLogic;
   Gui gui(coreLogic);
@@ -33,15 +53,24 @@ int main(int argc, char* argv[]) {
     return 1;
   }
 #ifdef __EMSCRIPTEN__
-  EmscriptenLoopArgs loopArgs = {&gui, &coreLogic};
+  EmscriptenLoopArgs loopArgs = {&gui, &coreLogic, {}};
   emscripten_set_main_loop_arg(emscripten_loop, &loopArgs, 0, true);
 #else
+  Trace::SetThreadName("Main");
+  Simulation simulation;
+  simulation.Start(coreLogic.GetParameters(), coreLogic.GetFps());
+  gui.SetSimulation(&simulation);
+
   while (gui.IsRunning()) {
-    if (!gui.IsPaused()) {
-      coreLogic.Update();
+    simulation.SetParameters(coreLogic.GetParameters(), coreLogic.GetFps());
+    simulation.SetPaused(gui.IsPaused());
+    {
+      FrameProfiler::Scope scope(gui.GetProfiler(), FramePhase::SIMULATION);
+      simulation.Drain(coreLogic);
     }
     gui.Run();
   }
+  simulation.Stop();
 #endif
   return 0;
 }
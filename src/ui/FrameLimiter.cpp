@@ -0,0 +1,30 @@
+#include "FrameLimiter.hpp"
+
+#include <thread>
+
+void FrameLimiter::SetTargetFps(double fps) {
+  target_fps_ = fps > 0.0 ? fps : 0.0;
+  period_ = target_fps_ > 0.0
+                ? std::chrono::duration_cast<Clock::duration>(
+                      std::chrono::duration<double>(1.0 / target_fps_))
+                : Clock::duration{};
+}
+
+void FrameLimiter::Wait() {
+  last_wait_ms_ = 0.0;
+  if (!IsEnabled()) return;
+
+  const Clock::time_point start = Clock::now();
+  next_ += period_;
+  if (next_ <= start) {
+    // Late (or first frame): no wait, schedule from now
+    next_ = start;
+    return;
+  }
+
+  if (next_ - start > SPIN_MARGIN) std::this_thread::sleep_until(next_ - SPIN_MARGIN);
+  while (Clock::now() < next_) {
+  }
+  last_wait_ms_ =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
@@ -0,0 +1,87 @@
+#include "FrameProfiler.hpp"
+
+#include <algorithm>
+
+FrameProfiler::FrameProfiler() : frames_(HISTORY_SIZE) {
+  sort_scratch_.reserve(HISTORY_SIZE);
+}
+
+void FrameProfiler::BeginFrame() {
+  const Clock::time_point now = Clock::now();
+  if (started_) {
+    current_.total_ms =
+        std::chrono::duration<float, std::milli>(now - frame_start_).count();
+    float measured = 0.f;
+    for (size_t i = 0; i < PHASE_COUNT; ++i) measured += current_.phase_ms[i];
+    current_.phase_ms[static_cast<size_t>(FramePhase::OTHER)] =
+        std::max(current_.total_ms - measured, 0.f);
+
+    frames_[next_] = current_;
+    next_ = (next_ + 1) % HISTORY_SIZE;
+    count_ = std::min(count_ + 1, HISTORY_SIZE);
+    UpdateSummary();
+  }
+  current_ = {};
+  frame_start_ = now;
+  started_ = true;
+}
+
+void FrameProfiler::Add(FramePhase phase, Clock::duration elapsed) {
+  current_.phase_ms[static_cast<size_t>(phase)] +=
+      std::chrono::duration<float, std::milli>(elapsed).count();
+}
+
+const FrameProfiler::Frame& FrameProfiler::GetFrame(size_t i) const {
+  const size_t oldest = count_ < HISTORY_SIZE ? 0 : next_;
+  return frames_[(oldest + i) % HISTORY_SIZE];
+}
+
+void FrameProfiler::UpdateSummary() {
+  sort_scratch_.clear();
+  means_.fill(0.f);
+  for (size_t i = 0; i < count_; ++i) {
+    const Frame& frame = GetFrame(i);
+    sort_scratch_.push_back(frame.total_ms);
+    for (size_t p = 0; p < PHASE_COUNT; ++p) means_[p] += frame.phase_ms[p];
+  }
+  for (float& mean : means_) mean /= static_cast<float>(count_);
+
+  // Nearest-rank percentiles
+  std::sort(sort_scratch_.begin(), sort_scratch_.end());
+  auto rank = [this](float p) {
+    size_t index = static_cast<size_t>(p * static_cast<float>(count_ - 1) + 0.5f);
+    return sort_scratch_[std::min(index, count_ - 1)];
+  };
+  percentiles_ = {rank(0.50f), rank(0.95f), rank(0.99f)};
+}
+
+const char* FrameProfiler::PhaseName(FramePhase phase) {
+  switch (phase) {
+    case FramePhase::EVENTS:
+      return "Events";
+    case FramePhase::SIMULATION:
+      return "Simulation";
+    case FramePhase::UI_UPDATE:
+      return "UI Update";
+    case FramePhase::CONTROL_PANEL:
+      return "Control Panel";
+    case FramePhase::VISUALIZATION:
+      return "Visualization";
+    case FramePhase::PROPERTIES_PANEL:
+      return "Properties";
+    case FramePhase::STATUS_PANEL:
+      return "Status Panel";
+    case FramePhase::IMGUI_RENDER:
+      return "ImGui::Render";
+    case FramePhase::RENDER_DRAW_DATA:
+      return "RenderDrawData";
+    case FramePhase::PRESENT:
+      return "Present";
+    case FramePhase::FRAME_LIMITER:
+      return "Frame Limiter";
+    case FramePhase::OTHER:
+    case FramePhase::COUNT:
+      break;
+  }
+  return "Other";
+}
@@ -2,6 +2,8 @@
 
 #include <numeric>
 #include <algorithm>
+#include <cstring>
+#include <ctime>
 #include <fstream>
 #include <filesystem>
 #include <string>
@@ -18,6 +20,8 @@
 #include <fmt/core.h>
 
 #include "Style.hpp"
+#include "Trace.hpp"
+#include "WaveKernels.hpp"
 
 Gui::Gui(CoreLogic& coreLogic)
     : window(nullptr),
@@ -50,13 +54,17 @@ bool Gui::Initialize() {
       window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
 #else
   renderer = SDL_CreateRenderer(
-      window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+      window, -1, SDL_RENDERER_ACCELERATED | (vsyncEnabled ? SDL_RENDERER_PRESENTVSYNC : 0));
 #endif
 
   if (!renderer) {
     fmt::print("Renderer creation failed: {}\n", SDL_GetError());
     return false;
   }
+#ifndef __EMSCRIPTEN__
+  // The web build's pacing is set on the main loop, which starts later
+  ApplyFramePacing();
+#endif
 
   fmt::print("Initializing ImGui...\n");
   IMGUI_CHECKVERSION();
@@ -89,6 +97,7 @@ bool Gui::Initialize() {
 void Gui::ProcessEvents() {
   SDL_Event event;
   while (SDL_PollEvent(&event)) {
+    lastEventTicks = SDL_GetTicks();
     ImGui_ImplSDL2_ProcessEvent(&event);
     if (event.type == SDL_QUIT) {
       running = false;
@@ -161,9 +170,16 @@ void Gui::Render() {
   }
 
   // Render ImGui
-  ImGui::Render();
-  ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer);
+  {
+    FrameProfiler::Scope scope(profiler, FramePhase::IMGUI_RENDER);
+    ImGui::Render();
+  }
+  {
+    FrameProfiler::Scope scope(profiler, FramePhase::RENDER_DRAW_DATA);
+    ImGui_ImplSDLRenderer2_RenderDrawData(ImGui::GetDrawData(), renderer);
+  }
 
+  FrameProfiler::Scope scope(profiler, FramePhase::PRESENT);
   SDL_RenderPresent(renderer);
 }
 
@@ -232,7 +248,10 @@ void Gui::RenderMainInterface() {
   // Left sidebar with resizable splitter
   if (showLeftSidebar) {
     ImGui::BeginChild("LeftPanel", ImVec2(leftSidebarWidth, mainAreaHeight), true);
-    RenderControlPanelContent();
+    {
+      FrameProfiler::Scope scope(profiler, FramePhase::CONTROL_PANEL);
+      RenderControlPanelContent();
+    }
     ImGui::EndChild();
 
     // Left splitter
@@ -267,7 +286,10 @@ void Gui::RenderMainInterface() {
 
   // Center visualization area
   ImGui::BeginChild("CenterPanel", ImVec2(centerWidth, mainAreaHeight), true);
-  RenderVisualizationContent();
+  {
+    FrameProfiler::Scope scope(profiler, FramePhase::VISUALIZATION);
+    RenderVisualizationContent();
+  }
   ImGui::EndChild();
 
   // Right sidebar with resizable splitter
@@ -302,7 +324,10 @@ void Gui::RenderMainInterface() {
 
     ImGui::SameLine();
     ImGui::BeginChild("RightPanel", ImVec2(rightSidebarWidth, mainAreaHeight), true);
-    RenderPropertiesPanelContent();
+    {
+      FrameProfiler::Scope scope(profiler, FramePhase::PROPERTIES_PANEL);
+      RenderPropertiesPanelContent();
+    }
     ImGui::EndChild();
   }
 
@@ -335,7 +360,10 @@ void Gui::RenderMainInterface() {
     ImGui::PopStyleColor(3);
 
     ImGui::BeginChild("BottomPanel", ImVec2(-1, bottomBarHeight), true);
-    RenderStatusPanelContent();
+    {
+      FrameProfiler::Scope scope(profiler, FramePhase::STATUS_PANEL);
+      RenderStatusPanelContent();
+    }
     ImGui::EndChild();
   }
 
@@ -376,6 +404,7 @@ void Gui::RenderMainInterface() {
   // Render modal dialogs
   if (showSettings) RenderSettingsModal();
   if (showAbout) RenderAboutModal();
+  if (showProfiler) RenderProfilerOverlay();
 }
 
 void Gui::RenderMenuBar() {
@@ -404,6 +433,7 @@ void Gui::RenderMenuBar() {
       ImGui::MenuItem("Control Panel", nullptr, &showLeftSidebar);
       ImGui::MenuItem("Properties", nullptr, &showRightSidebar);
       ImGui::MenuItem("Status Panel", nullptr, &showBottomPanel);
+      ImGui::MenuItem("Profiler Overlay", nullptr, &showProfiler);
       ImGui::Separator();
       if (ImGui::MenuItem("Reset Panel Sizes")) {
         ResetPanelSizes();
@@ -559,12 +589,13 @@ void Gui::RenderControlPanelContent() {
 
   ImGui::Spacing();
 
-  // FPS control
-  ImGui::Text("Update Rate (FPS)");
+  // Sample rate control (real samples per second, independent of the frame rate)
+  ImGui::Text("Sample Rate (Hz)");
   ImGui::PushStyleColor(ImGuiCol_SliderGrab, ImGui::Colors::WARNING);
 
   float fps = core_logic_.GetFps();
-  if (ImGui::SliderFloat("##FPS", &fps, 5.0f, 600.0f, "%.0f FPS")) {
+  if (ImGui::SliderFloat("##FPS", &fps, 5.0f, static_cast<float>(Simulation::MAX_SAMPLE_RATE), "%.0f Hz",
+                         ImGuiSliderFlags_Logarithmic)) {
     core_logic_.GetFps() = fps;
   }
   ImGui::PopStyleColor();
@@ -630,6 +661,146 @@ void Gui::RenderControlPanelContent() {
   if (ImGui::GradientButton("Sawtooth", waveButtonSize)) {
     core_logic_.GetWaveType() = WaveType::SAWTOOTH;
   }
+  ImGui::SameLine();
+  if (ImGui::GradientButton("Composite", waveButtonSize)) {
+    core_logic_.GetWaveType() = WaveType::COMPOSITE;
+  }
+
+  if (core_logic_.GetWaveType() == WaveType::COMPOSITE) {
+    RenderPartialsEditor();
+  }
+}
+
+void Gui::RenderPartialsEditor() {
+  ImGui::Spacing();
+  ImGui::Separator();
+  ImGui::Spacing();
+
+  ImGui::Text("Partials");
+  ImGui::Spacing();
+
+  // Edits go to a copy, which replaces the immutable set when anything changed
+  std::vector<Partial> partials = core_logic_.GetComposite()->GetPartials();
+  bool edited = false;
+
+  int count = static_cast<int>(partials.size());
+  ImGui::SetNextItemWidth(-1);
+  PushSliderThemeColors();
+  if (ImGui::SliderInt("##PartialCount", &count, 1,
+                       static_cast<int>(CompositeWave::MAX_PARTIALS), "%d partials")) {
+    // New partials continue the harmonic series
+    for (size_t i = partials.size(); i < static_cast<size_t>(count); ++i) {
+      const float ratio = static_cast<float>(i + 1);
+      partials.push_back({ratio, 1.0f / ratio, 0.0f});
+    }
+    partials.resize(count);
+    edited = true;
+  }
+  PopThemeColors(5);
+
+  ImVec2 presetSize = ImVec2((ImGui::GetContentRegionAvail().x - 10) / 2, 0);
+  if (ImGui::GradientButton("Saw Series", presetSize)) {
+    partials = CompositeWave::HarmonicSeries(partials.size());
+    edited = true;
+  }
+  ImGui::SameLine();
+  if (ImGui::GradientButton("Odd Series", presetSize)) {
+    partials = CompositeWave::HarmonicSeries(partials.size(), 2);
+    edited = true;
+  }
+
+  // One row per partial: ratio, amplitude, phase. Only visible rows are
+  // submitted, so the full 256 stay cheap.
+  ImGui::BeginChild("PartialRows", ImVec2(-1, 220), true);
+  const float fieldWidth = (ImGui::GetContentRegionAvail().x - 40.0f) / 3.0f;
+  ImGuiListClipper clipper;
+  clipper.Begin(static_cast<int>(partials.size()));
+  while (clipper.Step()) {
+    for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+      Partial& partial = partials[i];
+      ImGui::PushID(i);
+      ImGui::Text("%3d", i + 1);
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(fieldWidth);
+      edited |= ImGui::DragFloat("##Ratio", &partial.ratio, 0.01f, 0.0f,
+                                 CompositeWave::MAX_RATIO, "x%.3f");
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(fieldWidth);
+      edited |= ImGui::DragFloat("##Amplitude", &partial.amplitude, 0.005f, -1.0f, 1.0f, "%.3f");
+      ImGui::SameLine();
+      ImGui::SetNextItemWidth(fieldWidth);
+      edited |= ImGui::SliderFloat("##Phase", &partial.phase, 0.0f, 6.283f, "%.2f rad");
+      ImGui::PopID();
+    }
+  }
+  ImGui::EndChild();
+
+  if (edited) core_logic_.SetPartials(std::move(partials));
+  ImGui::TextDisabled("Ratio, amplitude and phase per partial | Peak %.2f",
+                      core_logic_.GetComposite()->GetPeak());
+}
+
+void Gui::RenderModulationEditor() {
+  const char* targetNames[] = {"Frequency", "Amplitude", "Phase"};
+  ModulationMatrix& matrix = channelBank.GetOscillators().GetModulation();
+  const int channelCount = static_cast<int>(channelBank.GetChannelCount());
+
+  ImGui::Text("Modulation");
+  ImGui::SameLine();
+  if (ImGui::Button("Add Route")) {
+    // Default: the edited channel drives the next one
+    ModRoute route;
+    route.source = static_cast<uint32_t>(channelEditIndex);
+    route.destination = static_cast<uint32_t>((channelEditIndex + 1) % channelCount);
+    matrix.AddRoute(route);
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Clear Routes")) matrix.Clear();
+  ImGui::SameLine();
+  ImGui::TextDisabled("%zu / %zu routes | FM and AM depth relative, PM in radians",
+                      matrix.GetRoutes().size(), ModulationMatrix::MAX_ROUTES);
+  if (matrix.IsEmpty()) return;
+
+  // One row per route: source, destination, target, depth
+  const float rowHeight = ImGui::GetFrameHeightWithSpacing();
+  const size_t visibleRows = std::min<size_t>(matrix.GetRoutes().size(), 4);
+  ImGui::BeginChild("ModulationRows", ImVec2(-1, rowHeight * visibleRows + 8), true);
+  int removed = -1;
+  for (size_t i = 0; i < matrix.GetRoutes().size(); ++i) {
+    ModRoute& route = matrix.GetRoute(i);
+    ImGui::PushID(static_cast<int>(i));
+    int source = static_cast<int>(route.source);
+    int destination = static_cast<int>(route.destination);
+    int target = static_cast<int>(route.target);
+    ImGui::SetNextItemWidth(100.0f);
+    if (ImGui::InputInt("##Source", &source)) {
+      route.source = static_cast<uint32_t>(std::clamp(source, 0, channelCount - 1));
+    }
+    ImGui::SameLine();
+    ImGui::Text("->");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(100.0f);
+    if (ImGui::InputInt("##Destination", &destination)) {
+      route.destination = static_cast<uint32_t>(std::clamp(destination, 0, channelCount - 1));
+    }
+    ImGui::SameLine();
+    PushComboThemeColors();
+    ImGui::SetNextItemWidth(120.0f);
+    if (ImGui::Combo("##Target", &target, targetNames, IM_ARRAYSIZE(targetNames))) {
+      route.target = static_cast<ModTarget>(target);
+    }
+    PopThemeColors(9);
+    ImGui::SameLine();
+    PushSliderThemeColors();
+    ImGui::SetNextItemWidth(160.0f);
+    ImGui::SliderFloat("##Depth", &route.depth, -4.0f, 4.0f, "Depth %.2f");
+    PopThemeColors(5);
+    ImGui::SameLine();
+    if (ImGui::Button("Remove")) removed = static_cast<int>(i);
+    ImGui::PopID();
+  }
+  ImGui::EndChild();
+  if (removed >= 0) matrix.RemoveRoute(static_cast<size_t>(removed));
 }
 
 void Gui::RenderVisualizationContent() {
@@ -638,7 +809,8 @@ void Gui::RenderVisualizationContent() {
   ImGui::PopStyleColor();
 
   // Display current wave parameters
-  const char* waveTypeNames[] = {"Sine", "Cosine", "Square", "Triangle", "Sawtooth"};
+  const char* waveTypeNames[] = {"Sine", "Cosine", "Square", "Triangle", "Sawtooth",
+                                 "Composite"};
   int waveTypeIndex = static_cast<int>(core_logic_.GetWaveType());
   ImGui::Text("Type: %s | Freq: %.1f Hz | Amp: %.1f | Phase: %.2f rad",
               waveTypeNames[waveTypeIndex],
@@ -657,8 +829,35 @@ void Gui::RenderVisualizationContent() {
   ImGui::Separator();
   ImGui::Spacing();
 
+  ImGui::PushStyleColor(ImGuiCol_Tab, ImGui::Colors::PRIMARY_MEDIUM);
+  ImGui::PushStyleColor(ImGuiCol_TabHovered, ImGui::Colors::ACCENT_HOVER);
+  ImGui::PushStyleColor(ImGuiCol_TabActive, ImGui::Colors::ACCENT_PRIMARY);
+  ImGui::PushStyleColor(ImGuiCol_TabUnfocused, ImGui::Colors::PRIMARY_DARK);
+  ImGui::PushStyleColor(ImGuiCol_TabUnfocusedActive, ImGui::Colors::ACCENT_SECONDARY);
+
+  if (ImGui::BeginTabBar("VisualizationTabs")) {
+    if (ImGui::BeginTabItem("Waveform")) {
+      RenderWaveformPlot();
+      ImGui::EndTabItem();
+    }
+    if (ImGui::BeginTabItem("Spectrum")) {
+      RenderSpectrumPlot();
+      ImGui::EndTabItem();
+    }
+    if (ImGui::BeginTabItem("Channels")) {
+      RenderChannelsPlot();
+      ImGui::EndTabItem();
+    }
+    ImGui::EndTabBar();
+  }
+
+  ImGui::PopStyleColor(5);
+}
+
+void Gui::RenderWaveformPlot() {
   // Enhanced sine wave plot
-  if (!core_logic_.GetSineWaveValues().empty()) {
+  const SampleView values = core_logic_.GetSamples();
+  if (!values.empty()) {
     ImDrawList* draw_list = ImGui::GetWindowDrawList();
     ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
     ImVec2 canvas_size = ImGui::GetContentRegionAvail();
@@ -682,11 +881,14 @@ void Gui::RenderVisualizationContent() {
     }
 
     // Draw enhanced sine wave
-    const auto& values = core_logic_.GetSineWaveValues();
-    const float scale_x = canvas_size.x / static_cast<float>(values.size() - 1);
     const float center_y = canvas_pos.y + canvas_size.y * 0.5f;
     const float scale_y = canvas_size.y * 0.4f / 10.0f;
 
+    // One prebuilt polyline per pass; at most two vertices per pixel column
+    const std::vector<ImVec2>& points = waveGeometry.Build(
+        values, core_logic_.GetPyramid(), canvas_pos, canvas_size, center_y, scale_y);
+    const int pointCount = static_cast<int>(points.size());
+
     // Get wave color from CoreLogic
     float* waveColorArray = core_logic_.GetWaveColor();
     ImVec4 waveColorVec = ImVec4(waveColorArray[0], waveColorArray[1], waveColorArray[2], 1.0f);
@@ -703,21 +905,13 @@ void Gui::RenderVisualizationContent() {
           alpha
         ));
 
-        for (size_t i = 0; i < values.size() - 1; i++) {
-          ImVec2 p1(canvas_pos.x + i * scale_x, center_y - values[i] * scale_y);
-          ImVec2 p2(canvas_pos.x + (i + 1) * scale_x, center_y - values[i + 1] * scale_y);
-          draw_list->AddLine(p1, p2, glow_color, thickness);
-        }
+        draw_list->AddPolyline(points.data(), pointCount, glow_color, ImDrawFlags_None, thickness);
       }
     }
 
     // Draw main wave line using custom wave color
     ImU32 wave_color = ImGui::GetColorU32(waveColorVec);
-    for (size_t i = 0; i < values.size() - 1; i++) {
-      ImVec2 p1(canvas_pos.x + i * scale_x, center_y - values[i] * scale_y);
-      ImVec2 p2(canvas_pos.x + (i + 1) * scale_x, center_y - values[i + 1] * scale_y);
-      draw_list->AddLine(p1, p2, wave_color, 2.0f);
-    }
+    draw_list->AddPolyline(points.data(), pointCount, wave_color, ImDrawFlags_None, 2.0f);
 
     // Draw center line
     draw_list->AddLine(
@@ -754,6 +948,292 @@ void Gui::RenderVisualizationContent() {
   }
 }
 
+void Gui::RenderSpectrumPlot() {
+  // Analysis settings
+  const char* sizeNames[] = {"64", "128", "256", "512", "1024", "2048",
+                             "4096", "8192", "16384", "32768", "65536"};
+  const char* windowNames[] = {"Rectangular", "Hann", "Blackman-Harris"};
+
+  PushComboThemeColors();
+  ImGui::SetNextItemWidth(120.0f);
+  ImGui::Combo("FFT Size", &spectrumSizeIndex, sizeNames, IM_ARRAYSIZE(sizeNames));
+  ImGui::SameLine();
+  ImGui::SetNextItemWidth(180.0f);
+  ImGui::Combo("Window", &spectrumWindow, windowNames, IM_ARRAYSIZE(windowNames));
+  PopThemeColors(9);
+  ImGui::SameLine();
+  ImGui::Checkbox("Log Frequency", &spectrumLogFrequency);
+
+  // Hand the newest history to the analyzer thread whenever the history or
+  // the settings changed; it declines while the previous transform runs
+  const size_t fftSize = SpectrumAnalyzer::MIN_SIZE << spectrumSizeIndex;
+  const SampleView values = core_logic_.GetSamples();
+  if (!values.empty() &&
+      (values.version != spectrumSubmittedVersion || fftSize != spectrumSubmittedSize ||
+       spectrumWindow != spectrumSubmittedWindow)) {
+    if (spectrumAnalyzer.Submit(values, fftSize, static_cast<FftWindow>(spectrumWindow),
+                                core_logic_.GetFps())) {
+      spectrumSubmittedVersion = values.version;
+      spectrumSubmittedSize = fftSize;
+      spectrumSubmittedWindow = spectrumWindow;
+    }
+  }
+  spectrumAnalyzer.Fetch(spectrum);
+
+  // Cost of the transform against the frame budget
+  const float frameMs = 1000.0f / ImGui::GetIO().Framerate;
+  const bool overBudget = spectrum.compute_ms > frameMs;
+  if (overBudget) ImGui::PushStyleColor(ImGuiCol_Text, ImGui::Colors::WARNING);
+  ImGui::Text("FFT: %.2f ms (%.0f%% of %.1f ms frame)", spectrum.compute_ms,
+              100.0 * spectrum.compute_ms / frameMs, frameMs);
+  if (overBudget) ImGui::PopStyleColor();
+
+  if (spectrum.magnitude_db.size() < 2) {
+    ImGui::PushStyleColor(ImGuiCol_Text, ImGui::Colors::TEXT_SECONDARY);
+    ImGui::Text("Waiting for data...");
+    ImGui::PopStyleColor();
+    return;
+  }
+
+  const size_t binCount = spectrum.magnitude_db.size();
+  const double binWidth = spectrum.BinFrequency(1);
+  const double nyquist = spectrum.BinFrequency(binCount - 1);
+
+  size_t peakBin = 1;
+  for (size_t k = 2; k < binCount; ++k) {
+    if (spectrum.magnitude_db[k] > spectrum.magnitude_db[peakBin]) peakBin = k;
+  }
+  ImGui::SameLine();
+  ImGui::Text("| Resolution: %.3f Hz | Peak: %.2f Hz (%.1f dB)", binWidth,
+              spectrum.BinFrequency(peakBin), spectrum.magnitude_db[peakBin]);
+
+  ImDrawList* draw_list = ImGui::GetWindowDrawList();
+  ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+  ImVec2 canvas_size = ImGui::GetContentRegionAvail();
+  canvas_size.y = std::max(canvas_size.y - 60, 200.0f);
+  ImVec2 canvas_end = ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y);
+
+  float* bgColor = core_logic_.GetBgColor();
+  draw_list->AddRectFilled(canvas_pos, canvas_end,
+                           ImGui::GetColorU32(ImVec4(bgColor[0], bgColor[1], bgColor[2], 1.0f)));
+
+  // Magnitude axis: a unit sine peaks at 0 dB
+  const float minDb = -120.0f;
+  const float maxDb = 20.0f;
+  auto dbToY = [&](float db) {
+    float t = (std::clamp(db, minDb, maxDb) - minDb) / (maxDb - minDb);
+    return canvas_end.y - t * canvas_size.y;
+  };
+  ImU32 grid_color = ImGui::GetColorU32(ImVec4(0.3f, 0.3f, 0.3f, 0.2f));
+  ImU32 label_color = ImGui::GetColorU32(ImGui::Colors::TEXT_SECONDARY);
+  for (float db = minDb; db <= maxDb; db += 20.0f) {
+    float y = dbToY(db);
+    draw_list->AddLine(ImVec2(canvas_pos.x, y), ImVec2(canvas_end.x, y), grid_color);
+    draw_list->AddText(ImVec2(canvas_pos.x + 4, y - ImGui::GetFontSize()), label_color,
+                       fmt::format("{:.0f} dB", db).c_str());
+  }
+
+  // Frequency axis; the log axis starts at the first non-DC bin
+  auto columnToFrequency = [&](float t) {
+    return spectrumLogFrequency ? binWidth * std::pow(nyquist / binWidth, t) : t * nyquist;
+  };
+  const int tickCount = 5;
+  for (int i = 0; i <= tickCount; ++i) {
+    float t = static_cast<float>(i) / tickCount;
+    float x = canvas_pos.x + t * canvas_size.x;
+    draw_list->AddLine(ImVec2(x, canvas_pos.y), ImVec2(x, canvas_end.y), grid_color);
+    draw_list->AddText(ImVec2(std::min(x + 4, canvas_end.x - 80), canvas_end.y - ImGui::GetFontSize()),
+                       label_color, fmt::format("{:.1f} Hz", columnToFrequency(t)).c_str());
+  }
+
+  // One vertex per pixel column, holding the loudest bin under it
+  const size_t columns = std::max<size_t>(static_cast<size_t>(canvas_size.x), 2);
+  spectrumPoints.clear();
+  spectrumPoints.reserve(columns);
+  for (size_t c = 0; c < columns; ++c) {
+    double f0 = columnToFrequency(static_cast<float>(c) / columns);
+    double f1 = columnToFrequency(static_cast<float>(c + 1) / columns);
+    size_t first = std::min(static_cast<size_t>(f0 / binWidth + 0.5), binCount - 1);
+    size_t last = std::clamp(static_cast<size_t>(f1 / binWidth + 0.5), first + 1, binCount);
+    float peak = *std::max_element(spectrum.magnitude_db.begin() + first,
+                                   spectrum.magnitude_db.begin() + last);
+    spectrumPoints.emplace_back(canvas_pos.x + c * canvas_size.x / (columns - 1), dbToY(peak));
+  }
+
+  float* waveColorArray = core_logic_.GetWaveColor();
+  ImVec4 waveColorVec = ImVec4(waveColorArray[0], waveColorArray[1], waveColorArray[2], 1.0f);
+  draw_list->AddPolyline(spectrumPoints.data(), static_cast<int>(spectrumPoints.size()),
+                         ImGui::GetColorU32(waveColorVec), ImDrawFlags_None, 2.0f);
+
+  ImGui::InvisibleButton("spectrum_canvas", canvas_size);
+}
+
+void Gui::RenderChannelsPlot() {
+  const char* waveTypeNames[] = {"Sine", "Cosine", "Square", "Triangle", "Sawtooth",
+                                 "Composite"};
+  const char* viewNames[] = {"Overlay", "Stacked"};
+
+  // Bank settings
+  ImGui::Checkbox("Run Bank", &channelBankEnabled);
+  ImGui::SameLine();
+  int channelCount = static_cast<int>(channelBank.GetChannelCount());
+  ImGui::SetNextItemWidth(160.0f);
+  PushSliderThemeColors();
+  if (ImGui::SliderInt("Channels", &channelCount, 1,
+                       static_cast<int>(OscillatorBank::MAX_CHANNELS))) {
+    channelBank.Resize(channelCount, channelBank.GetHistoryCapacity());
+  }
+  ImGui::SameLine();
+  ImGui::SetNextItemWidth(160.0f);
+  ImGui::SliderFloat("Bank Rate", &channelSampleRate, 10.0f, 100000.0f, "%.0f Hz",
+                     ImGuiSliderFlags_Logarithmic);
+  PopThemeColors(5);
+  ImGui::SameLine();
+  PushComboThemeColors();
+  ImGui::SetNextItemWidth(120.0f);
+  ImGui::Combo("View", &channelViewMode, viewNames, IM_ARRAYSIZE(viewNames));
+  PopThemeColors(9);
+
+  // Shown subset and the parameters of one channel
+  channelCount = static_cast<int>(channelBank.GetChannelCount());
+  ImGui::SetNextItemWidth(120.0f);
+  ImGui::InputInt("First", &channelFirst);
+  channelFirst = std::clamp(channelFirst, 0, channelCount - 1);
+  ImGui::SameLine();
+  ImGui::SetNextItemWidth(160.0f);
+  PushSliderThemeColors();
+  ImGui::SliderInt("Shown", &channelShown, 1, MAX_SHOWN_CHANNELS);
+  PopThemeColors(5);
+  ImGui::SameLine();
+  ImGui::SetNextItemWidth(120.0f);
+  ImGui::InputInt("Edit Channel", &channelEditIndex);
+  channelEditIndex = std::clamp(channelEditIndex, 0, channelCount - 1);
+
+  OscillatorBank& oscillators = channelBank.GetOscillators();
+  WaveParams params = oscillators.GetChannel(channelEditIndex);
+  int waveType = static_cast<int>(params.wave_type);
+  bool edited = false;
+  PushComboThemeColors();
+  ImGui::SetNextItemWidth(120.0f);
+  edited |= ImGui::Combo("##ChannelType", &waveType, waveTypeNames, IM_ARRAYSIZE(waveTypeNames));
+  PopThemeColors(9);
+  ImGui::SameLine();
+  PushSliderThemeColors();
+  ImGui::SetNextItemWidth(140.0f);
+  edited |= ImGui::SliderFloat("##ChannelFrequency", &params.frequency, 0.1f, 1000.0f, "%.2f Hz",
+                               ImGuiSliderFlags_Logarithmic);
+  ImGui::SameLine();
+  ImGui::SetNextItemWidth(120.0f);
+  edited |= ImGui::SliderFloat("##ChannelAmplitude", &params.amplitude, 0.1f, 10.0f, "Amp %.2f");
+  ImGui::SameLine();
+  ImGui::SetNextItemWidth(120.0f);
+  edited |= ImGui::SliderFloat("##ChannelPhase", &params.phase, 0.0f, 6.283f, "Phase %.2f");
+  ImGui::SameLine();
+  ImGui::SetNextItemWidth(120.0f);
+  edited |= ImGui::SliderFloat("##ChannelNoise", &params.noise, 0.0f, 1.0f, "Noise %.2f");
+  PopThemeColors(5);
+  if (edited) {
+    params.wave_type = static_cast<WaveType>(waveType);
+    // Channels switched to Composite start from the main wave's partials
+    if (!params.composite) params.composite = core_logic_.GetComposite();
+    oscillators.SetChannel(channelEditIndex, params);
+  }
+  ImGui::SameLine();
+  if (ImGui::Button("Copy Main Wave")) {
+    oscillators.SetChannel(channelEditIndex, core_logic_.GetParameters());
+  }
+  ImGui::SameLine();
+  // Restarts the noise of every channel; each derives its stream from the
+  // seed and its index
+  uint64_t bankSeed = oscillators.GetSeed();
+  ImGui::SetNextItemWidth(170.0f);
+  const bool bankSeedEntered =
+      ImGui::InputScalar("##BankSeed", ImGuiDataType_U64, &bankSeed, nullptr, nullptr,
+                         nullptr, ImGuiInputTextFlags_EnterReturnsTrue);
+  ImGui::SameLine();
+  if (ImGui::Button("Reseed Bank") || bankSeedEntered) oscillators.SetSeed(bankSeed);
+
+  RenderModulationEditor();
+
+  ImGui::Text("Workers: %zu | Generation: %.2f ms/frame | Throughput: %.1f M samples/s",
+              workerPool ? workerPool->GetWorkerCount() + 1 : size_t{1}, channelAdvanceMs,
+              channelThroughput / 1e6);
+
+  // Plot of the shown channels, each in its own hue
+  const int first = channelFirst;
+  const int shown = std::min(channelShown, channelCount - first);
+  if (static_cast<int>(channelGeometry.size()) < shown) channelGeometry.resize(shown);
+
+  ImDrawList* draw_list = ImGui::GetWindowDrawList();
+  ImVec2 canvas_pos = ImGui::GetCursorScreenPos();
+  ImVec2 canvas_size = ImGui::GetContentRegionAvail();
+  canvas_size.y = std::max(canvas_size.y - 60, 200.0f);
+  ImVec2 canvas_end = ImVec2(canvas_pos.x + canvas_size.x, canvas_pos.y + canvas_size.y);
+
+  float* bgColor = core_logic_.GetBgColor();
+  draw_list->AddRectFilled(canvas_pos, canvas_end,
+                           ImGui::GetColorU32(ImVec4(bgColor[0], bgColor[1], bgColor[2], 1.0f)));
+
+  // Stacked lanes split the height; overlaid channels share the full canvas
+  const bool stacked = channelViewMode == 1;
+  const float laneHeight = stacked ? canvas_size.y / shown : canvas_size.y;
+  ImU32 grid_color = ImGui::GetColorU32(ImVec4(0.3f, 0.3f, 0.3f, 0.2f));
+  ImU32 label_color = ImGui::GetColorU32(ImGui::Colors::TEXT_SECONDARY);
+
+  for (int i = 0; i < shown; ++i) {
+    const size_t channel = static_cast<size_t>(first + i);
+    const SampleView values = channelBank.GetSamples(channel);
+    if (values.empty()) continue;
+
+    const float laneTop = canvas_pos.y + (stacked ? i * laneHeight : 0.0f);
+    const float center_y = laneTop + laneHeight * 0.5f;
+    const float scale_y = laneHeight * 0.4f / 10.0f;
+    const ImVec2 lane_pos(canvas_pos.x, laneTop);
+    const ImVec2 lane_size(canvas_size.x, laneHeight);
+
+    float r, g, b;
+    ImGui::ColorConvertHSVtoRGB(static_cast<float>(i) / shown, 0.65f, 0.95f, r, g, b);
+    const ImU32 color = ImGui::GetColorU32(ImVec4(r, g, b, 1.0f));
+
+    if (stacked) {
+      draw_list->AddLine(ImVec2(canvas_pos.x, laneTop), ImVec2(canvas_end.x, laneTop), grid_color);
+    }
+    const std::vector<ImVec2>& points = channelGeometry[i].Build(
+        values, channelBank.GetPyramid(channel), lane_pos, lane_size, center_y, scale_y);
+    draw_list->AddPolyline(points.data(), static_cast<int>(points.size()), color,
+                           ImDrawFlags_None, 1.5f);
+    if (stacked || i == 0) {
+      const std::string label = stacked ? fmt::format("#{}", channel)
+                                        : fmt::format("#{} - #{}", first, first + shown - 1);
+      draw_list->AddText(ImVec2(canvas_pos.x + 4, laneTop + 2), stacked ? color : label_color,
+                         label.c_str());
+    }
+  }
+
+  ImGui::InvisibleButton("channels_canvas", canvas_size);
+}
+
+void Gui::AdvanceChannelBank() {
+  const double rate = channelSampleRate;
+  const auto now = SampleClock::Clock::now();
+  if (!channelBankEnabled || paused || channelClock.GetRate() != rate) {
+    channelClock.Start(rate, now);
+    return;
+  }
+  if (!workerPool) workerPool = std::make_unique<ThreadPool>();
+
+  // Catch up at most 100 ms after a stall
+  const size_t due = channelClock.Advance(now, static_cast<size_t>(rate * 0.1) + 1);
+  if (due == 0) return;
+  const auto start = SampleClock::Clock::now();
+  channelBank.Advance(due, rate, workerPool.get());
+  const double seconds = std::chrono::duration<double>(SampleClock::Clock::now() - start).count();
+  channelAdvanceMs = static_cast<float>(seconds * 1000.0);
+  if (seconds > 0.0) {
+    channelThroughput = static_cast<double>(due) * channelBank.GetChannelCount() / seconds;
+  }
+}
+
 void Gui::RenderPropertiesPanelContent() {
   ImGui::PushStyleColor(ImGuiCol_Text, ImGui::Colors::ACCENT_PRIMARY);
   ImGui::Text("Properties");
@@ -776,7 +1256,8 @@ void Gui::RenderPropertiesPanelContent() {
 
       // Wave type selection
       ImGui::Text("Wave Type");
-      const char* waveTypes[] = {"Sine", "Cosine", "Square", "Triangle", "Sawtooth"};
+      const char* waveTypes[] = {"Sine", "Cosine", "Square", "Triangle", "Sawtooth",
+                                 "Composite"};
       int currentWaveType = static_cast<int>(core_logic_.GetWaveType());
 
       // Apply theme colors to combo box
@@ -794,11 +1275,29 @@ void Gui::RenderPropertiesPanelContent() {
           "Cosine: Sine wave shifted by 90 degrees",
           "Square: Digital wave with sharp transitions",
           "Triangle: Linear wave with sharp peaks",
-          "Sawtooth: Ramp wave used in synthesizers"
+          "Sawtooth: Ramp wave used in synthesizers",
+          "Composite: Sum of partials edited in the Control Panel"
         };
         ImGui::SetTooltip("%s", tooltips[currentWaveType]);
       }
 
+      // Band-limiting only changes the shapes with jumps or corners
+      ImGui::Text("Generation");
+      const char* generationNames[] = {"Naive", "Band-limited (PolyBLEP)",
+                                       "Wavetable (linear)", "Wavetable (cubic)"};
+      int generation = static_cast<int>(core_logic_.GetGenerationMode());
+      PushComboThemeColors();
+      if (ImGui::Combo("##Generation", &generation, generationNames, IM_ARRAYSIZE(generationNames))) {
+        core_logic_.GetGenerationMode() = static_cast<GenerationMode>(generation);
+      }
+      PopThemeColors(9);
+      if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Band-limited square, triangle and sawtooth waves do not alias\n"
+                          "at high frequencies, at almost no extra cost.\n"
+                          "Wavetables replay precomputed band-limited cycles, one table\n"
+                          "per octave, for every wave type");
+      }
+
       ImGui::Spacing();
       ImGui::Separator();
       ImGui::Spacing();
@@ -823,6 +1322,24 @@ void Gui::RenderPropertiesPanelContent() {
       ImGui::SliderFloat("##Noise", &noise, 0.0f, 1.0f, "%.3f");
       PopThemeColors(5);
 
+      // Uniform noise spans +-level; Gaussian noise has level as its deviation
+      const char* noiseTypeNames[] = {"Uniform", "Gaussian"};
+      int noiseType = static_cast<int>(core_logic_.GetNoiseType());
+      PushComboThemeColors();
+      if (ImGui::Combo("Distribution", &noiseType, noiseTypeNames, IM_ARRAYSIZE(noiseTypeNames))) {
+        core_logic_.GetNoiseType() = static_cast<NoiseType>(noiseType);
+      }
+      PopThemeColors(9);
+
+      // Equal seeds repeat the noise exactly; Enter applies a new seed
+      uint64_t seed = core_logic_.GetNoiseSeed();
+      ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x - 70.0f);
+      const bool seedEntered =
+          ImGui::InputScalar("##NoiseSeed", ImGuiDataType_U64, &seed, nullptr, nullptr,
+                             nullptr, ImGuiInputTextFlags_EnterReturnsTrue);
+      ImGui::SameLine();
+      if (ImGui::Button("Reseed") || seedEntered) ReseedNoise(seed);
+
       ImGui::EndTabItem();
     }
 
@@ -969,6 +1486,28 @@ void Gui::RenderPropertiesPanelContent() {
       ImGui::Separator();
       ImGui::Spacing();
 
+      // History length (ring buffer capacity)
+      ImGui::Text("History Length");
+      const char* historyLabels[] = {"500", "5K", "50K", "500K", "5M", "10M"};
+      const size_t historySizes[] = {500, 5000, 50000, 500000, 5000000, 10000000};
+      int historyIndex = 0;
+      for (int i = 0; i < IM_ARRAYSIZE(historySizes); i++) {
+        if (historySizes[i] == core_logic_.GetHistoryCapacity()) historyIndex = i;
+      }
+
+      PushComboThemeColors();
+      if (ImGui::Combo("##HistoryLength", &historyIndex, historyLabels, IM_ARRAYSIZE(historyLabels))) {
+        core_logic_.SetHistoryCapacity(historySizes[historyIndex]);
+      }
+      PopThemeColors(9);
+      if (ImGui::IsItemHovered()) {
+        ImGui::SetTooltip("Number of samples kept in the history buffer.\nChanging it clears the current history.");
+      }
+
+      ImGui::Spacing();
+      ImGui::Separator();
+      ImGui::Spacing();
+
       // Advanced Color Settings
       ImGui::Text("Custom Colors");
       float* waveColor = core_logic_.GetWaveColor();
@@ -1003,12 +1542,84 @@ void Gui::RenderPropertiesPanelContent() {
         // Future: implement PNG export
       }
 
-      if (ImGui::GradientButton("Export as CSV", ImVec2(-1, 0))) {
-        // Future: implement CSV export
+      // CSV export streams every new sample until stopped
+      if (ImGui::GradientButton(csvRecorder.IsRecording() ? "Stop CSV Recording" : "Export as CSV",
+                                ImVec2(-1, 0))) {
+        csvStatus.clear();
+        ToggleRecording(csvRecorder, "csv");
+      }
+      if (csvRecorder.IsRecording()) {
+        ImGui::PushStyleColor(ImGuiCol_Text, ImGui::Colors::TEXT_SECONDARY);
+        ImGui::TextWrapped("Recording to %s", csvRecorder.GetPath().c_str());
+        ImGui::Text("%llu samples, %.1f MB",
+                    static_cast<unsigned long long>(csvRecorder.GetWrittenSamples()),
+                    csvRecorder.GetWrittenBytes() / (1024.0 * 1024.0));
+        ImGui::PopStyleColor();
+      }
+      RenderRecorderFailure(csvRecorder);
+      if (!csvStatus.empty()) {
+        ImGui::PushStyleColor(ImGuiCol_Text, ImGui::Colors::WARNING);
+        ImGui::TextWrapped("%s", csvStatus.c_str());
+        ImGui::PopStyleColor();
+      }
+      if (csvRecorder.GetDroppedSamples() > 0) {
+        ImGui::PushStyleColor(ImGuiCol_Text, ImGui::Colors::WARNING);
+        ImGui::Text("Dropped: %llu samples",
+                    static_cast<unsigned long long>(csvRecorder.GetDroppedSamples()));
+        ImGui::PopStyleColor();
       }
 
-      if (ImGui::GradientButton("Export as WAV", ImVec2(-1, 0))) {
-        // Future: implement WAV export
+      ImGui::Spacing();
+      ImGui::Text("WAV Export");
+      const char* wavFormats[] = {"16-bit PCM", "24-bit PCM", "32-bit Float"};
+      PushComboThemeColors();
+      ImGui::Combo("Format##Wav", &wavFormat, wavFormats, IM_ARRAYSIZE(wavFormats));
+      PopThemeColors(9);
+      PushSliderThemeColors();
+      ImGui::SliderFloat("Duration (s)", &wavDuration, 1.0f, 600.0f, "%.0f");
+      ImGui::SliderInt("Rate (Hz)", &wavSampleRate, 8000, 192000);
+      PopThemeColors(5);
+
+      // Offline: render the current configuration as fast as possible, off
+      // the UI thread
+      UpdateWavExport();
+      ImGui::BeginDisabled(wavExportRunning);
+      if (ImGui::GradientButton(wavExportRunning ? "Exporting WAV..." : "Export as WAV",
+                                ImVec2(-1, 0))) {
+        RenderWavExport();
+      }
+      ImGui::EndDisabled();
+      if (wavExportRunning) {
+        const float fraction =
+            wavExportTotal > 0
+                ? static_cast<float>(wavExportProgress.load()) / static_cast<float>(wavExportTotal)
+                : 0.0f;
+        ImGui::ProgressBar(fraction, ImVec2(-1, 0));
+      }
+      // Live: record the simulated signal at the simulation sample rate; a
+      // rate change stops the recording, since the header holds one rate
+      if (ImGui::GradientButton(wavRecorder.IsRecording() ? "Stop WAV Recording" : "Record WAV",
+                                ImVec2(-1, 0))) {
+        if (!wavRecorder.IsRecording()) {
+          wavStatus.clear();
+          const float fullScale = core_logic_.GetParameters().Peak();
+          wavRecorder.SetFormat(static_cast<WavFormat>(wavFormat), std::max(fullScale, 1e-6f));
+        }
+        ToggleRecording(wavRecorder, "wav");
+      }
+      if (wavRecorder.IsRecording()) {
+        ImGui::PushStyleColor(ImGuiCol_Text, ImGui::Colors::TEXT_SECONDARY);
+        ImGui::TextWrapped("Recording to %s", wavRecorder.GetPath().c_str());
+        ImGui::Text("%llu samples, %.1f MB",
+                    static_cast<unsigned long long>(wavRecorder.GetWrittenSamples()),
+                    wavRecorder.GetWrittenBytes() / (1024.0 * 1024.0));
+        ImGui::PopStyleColor();
+      }
+      RenderRecorderFailure(wavRecorder);
+      if (!wavStatus.empty()) {
+        ImGui::PushStyleColor(ImGuiCol_Text, ImGui::Colors::TEXT_SECONDARY);
+        ImGui::TextWrapped("%s", wavStatus.c_str());
+        ImGui::PopStyleColor();
       }
 
       ImGui::Spacing();
@@ -1024,7 +1635,8 @@ void Gui::RenderPropertiesPanelContent() {
           std::filesystem::create_directories("exports");
           std::ofstream settingsFile("exports/wave_settings.txt");
           if (settingsFile.is_open()) {
-            const char* waveTypeNames[] = {"Sine", "Cosine", "Square", "Triangle", "Sawtooth"};
+            const char* waveTypeNames[] = {"Sine", "Cosine", "Square", "Triangle", "Sawtooth",
+                                           "Composite"};
             int waveTypeIndex = static_cast<int>(core_logic_.GetWaveType());
             float* waveColor = core_logic_.GetWaveColor();
             float* bgColor = core_logic_.GetBgColor();
@@ -1035,7 +1647,7 @@ void Gui::RenderPropertiesPanelContent() {
             settingsFile << "Amplitude: " << core_logic_.GetAmplitude() << std::endl;
             settingsFile << "Phase: " << core_logic_.GetPhase() << " rad" << std::endl;
             settingsFile << "Noise: " << core_logic_.GetNoise() << std::endl;
-            settingsFile << "FPS: " << core_logic_.GetFps() << std::endl;
+            settingsFile << "Sample Rate: " << core_logic_.GetFps() << " Hz" << std::endl;
             settingsFile << "Wave Color RGB: " << waveColor[0] << ", " << waveColor[1] << ", " << waveColor[2] << std::endl;
             settingsFile << "Background Color RGB: " << bgColor[0] << ", " << bgColor[1] << ", " << bgColor[2] << std::endl;
             settingsFile << "Theme: " << currentThemeName << std::endl;
@@ -1071,31 +1683,42 @@ void Gui::RenderStatusPanelContent() {
   ImGui::Separator();
   ImGui::Text("Frame Rate: %.1f FPS", ImGui::GetIO().Framerate);
   ImGui::Text("Frame Time: %.3f ms", 1000.0f / ImGui::GetIO().Framerate);
+  ImGui::Text("Pacing: %s", GetFramePacingName().c_str());
+  if (frameLimiter.IsEnabled()) {
+    ImGui::Text("Limiter Wait: %.2f ms", frameLimiter.GetLastWaitMs());
+  }
 
   // Memory usage approximation
-  size_t dataPoints = core_logic_.GetSineWaveValues().size();
+  const SampleView values = core_logic_.GetSamples();
+  size_t dataPoints = values.size();
   float memoryUsage = dataPoints * sizeof(float) / 1024.0f; // KB
   ImGui::Text("Memory: %.1f KB", memoryUsage);
+  if (simulation_) {
+    ImGui::Text("Sample Rate: %.0f Hz", simulation_->GetMeasuredRate());
+    ImGui::Text("Dropped: %llu", static_cast<unsigned long long>(simulation_->GetDroppedSamples()));
+  }
 
   ImGui::NextColumn();
 
   // Wave statistics
   ImGui::Text("Wave Analysis");
   ImGui::Separator();
-  if (!core_logic_.GetSineWaveValues().empty()) {
-    const auto& values = core_logic_.GetSineWaveValues();
-
-    float minVal = *std::min_element(values.begin(), values.end());
-    float maxVal = *std::max_element(values.begin(), values.end());
-    float avgVal = std::accumulate(values.begin(), values.end(), 0.0f) / values.size();
+  if (!values.empty()) {
+    const RunningStats& stats = core_logic_.GetStats();
+    float minVal = stats.GetMin();
+    float maxVal = stats.GetMax();
+    float avgVal = static_cast<float>(stats.GetMean());
 
     ImGui::Text("Min: %.3f", minVal);
     ImGui::Text("Max: %.3f", maxVal);
     ImGui::Text("Avg: %.3f", avgVal);
     ImGui::Text("Range: %.3f", maxVal - minVal);
+    ImGui::Text("Std Dev: %.3f", stats.GetStdDev());
+    ImGui::Text("RMS: %.3f", stats.GetRms());
 
     // Current wave parameters
-    const char* waveTypeNames[] = {"Sine", "Cosine", "Square", "Triangle", "Sawtooth"};
+    const char* waveTypeNames[] = {"Sine", "Cosine", "Square", "Triangle", "Sawtooth",
+                                   "Composite"};
     int waveTypeIndex = static_cast<int>(core_logic_.GetWaveType());
     ImGui::Text("Type: %s", waveTypeNames[waveTypeIndex]);
     ImGui::Text("Phase: %.2f rad", core_logic_.GetPhase());
@@ -1111,7 +1734,8 @@ void Gui::RenderStatusPanelContent() {
   ImGui::Separator();
   ImGui::Text("Renderer: SDL2");
   ImGui::Text("UI: ImGui %.2s", ImGui::GetVersion());
-  ImGui::Text("Samples: %zu", core_logic_.GetSineWaveValues().size());
+  ImGui::Text("SIMD: %s", WaveKernels::IsaName(WaveKernels::ActiveIsa()));
+  ImGui::Text("Samples: %zu", dataPoints);
 
   ImGui::NextColumn();
 
@@ -1153,6 +1777,109 @@ void Gui::RenderStatusPanelContent() {
   ImGui::Columns(1);
 }
 
+void Gui::ToggleRecording(SampleRecorder& recorder, const char* extension) {
+  if (recorder.IsRecording()) {
+    core_logic_.RemoveSink(&recorder);
+    if (!recorder.Stop()) {
+      fmt::print(fg(fmt::color::red), "Recording to {} failed: {}\n", recorder.GetPath(),
+                 std::strerror(recorder.GetError()));
+      return;
+    }
+    fmt::print("Recording stopped: {} samples written to {}\n",
+               recorder.GetWrittenSamples(), recorder.GetPath());
+    return;
+  }
+
+  std::string path = MakeExportPath("samples", extension);
+  if (path.empty()) return;
+  if (!recorder.Start(path, core_logic_.GetFps())) {
+    fmt::print(fg(fmt::color::red), "Failed to open {} for recording\n", path);
+    return;
+  }
+  core_logic_.AddSink(&recorder);
+}
+
+void Gui::StopRecordingOnRateChange(SampleRecorder& recorder, const char* extension,
+                                    std::string& status) {
+  if (!recorder.IsRecording() || recorder.GetSampleRate() == core_logic_.GetFps()) return;
+  const std::string path = recorder.GetPath();
+  ToggleRecording(recorder, extension);
+  status = fmt::format("Recording to {} stopped: the sample rate changed", path);
+  fmt::print(fg(fmt::color::yellow), "{}\n", status);
+}
+
+void Gui::ReseedNoise(uint64_t seed) {
+  core_logic_.SetNoiseSeed(seed);
+  // The live signal comes from the simulation thread when there is one
+  if (simulation_) simulation_->Reseed(seed);
+}
+
+void Gui::RenderRecorderFailure(const SampleRecorder& recorder) {
+  if (!recorder.HasFailed()) return;
+  ImGui::PushStyleColor(ImGuiCol_Text, ImGui::Colors::ERROR);
+  ImGui::TextWrapped("Write to %s failed (%s) after %.1f MB; later samples were discarded",
+                     recorder.GetPath().c_str(), std::strerror(recorder.GetError()),
+                     recorder.GetWrittenBytes() / (1024.0 * 1024.0));
+  ImGui::PopStyleColor();
+}
+
+void Gui::RenderWavExport() {
+  if (wavExportRunning) return;
+  std::string path = MakeExportPath("render", "wav");
+  if (path.empty()) return;
+
+  wavExportPath = path;
+  wavExportTotal = static_cast<uint64_t>(std::llround(wavDuration * wavSampleRate));
+  wavExportProgress = 0;
+  wavExportDone = false;
+  wavExportRunning = true;
+  wavStatus = fmt::format("Rendering to {}", path);
+  // The render works on copies, so the UI keeps editing meanwhile
+  auto render = [this, params = core_logic_.GetParameters(),
+                 rate = static_cast<uint32_t>(wavSampleRate), duration = wavDuration,
+                 format = static_cast<WavFormat>(wavFormat),
+                 seed = core_logic_.GetNoiseSeed()]() {
+    wavExportOk = RenderWavFile(wavExportPath, params, rate, duration, format,
+                                &wavExportStats, seed, &wavExportProgress);
+    wavExportDone = true;
+  };
+#ifdef __EMSCRIPTEN__
+  render();
+#else
+  wavExportThread = std::thread(render);
+#endif
+}
+
+void Gui::UpdateWavExport() {
+  if (!wavExportRunning || !wavExportDone.load()) return;
+  if (wavExportThread.joinable()) wavExportThread.join();
+  wavExportRunning = false;
+
+  if (!wavExportOk) {
+    wavStatus = fmt::format("Failed to write {}", wavExportPath);
+    fmt::print(fg(fmt::color::red), "{}\n", wavStatus);
+    return;
+  }
+  wavStatus = fmt::format("Rendered {} samples to {} in {:.1f} ms ({:.1f} M samples/s)",
+                          wavExportStats.frames, wavExportPath,
+                          wavExportStats.seconds * 1000.0,
+                          wavExportStats.samples_per_second / 1e6);
+  fmt::print("{}\n", wavStatus);
+}
+
+std::string Gui::MakeExportPath(const char* prefix, const char* extension) {
+  try {
+    std::filesystem::create_directories("exports");
+  } catch (const std::exception& e) {
+    fmt::print("Failed to create exports directory: {}\n", e.what());
+    return {};
+  }
+  char timestamp[32];
+  std::time_t now = std::time(nullptr);
+  std::strftime(timestamp, sizeof(timestamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+  return fmt::format("exports/{}_{}.{}", prefix, timestamp, extension);
+}
+
 void Gui::RenderControlPanel() {
   // This method is kept for compatibility but content moved to RenderControlPanelContent
 }
@@ -1413,13 +2140,72 @@ void Gui::RenderSettingsModal() {
       }
 
       if (ImGui::BeginTabItem("Performance")) {
-        ImGui::Text("Rendering Settings");
+        ImGui::Text("Frame Pacing");
+        ImGui::Spacing();
 
-        static bool vsync = true;
-        ImGui::Checkbox("V-Sync", &vsync);
+        bool pacingChanged = false;
+        ImGui::BeginDisabled(benchmarkMode);
+        pacingChanged |= ImGui::Checkbox("V-Sync", &vsyncEnabled);
+        pacingChanged |= ImGui::Checkbox("Limit Frame Rate", &frameCapEnabled);
+        ImGui::BeginDisabled(!frameCapEnabled);
+        PushSliderThemeColors();
+        pacingChanged |= ImGui::SliderInt("Max FPS", &frameCapFps, 10, 480);
+        PopThemeColors(5);
+        ImGui::EndDisabled();
+        ImGui::EndDisabled();
+
+        pacingChanged |= ImGui::Checkbox("Benchmark Mode (uncapped)", &benchmarkMode);
+        if (ImGui::IsItemHovered()) {
+          ImGui::SetTooltip("Disables V-Sync and the frame cap to measure the raw frame rate");
+        }
+        if (pacingChanged) ApplyFramePacing();
 
-        static int maxFPS = 120;
-        ImGui::SliderInt("Max FPS", &maxFPS, 30, 240);
+        ImGui::Spacing();
+        ImGui::Text("Mode: %s", GetFramePacingName().c_str());
+        if (!vsyncApplied) {
+          ImGui::PushStyleColor(ImGuiCol_Text, ImGui::Colors::WARNING);
+          ImGui::TextWrapped("This renderer cannot change V-Sync at runtime");
+          ImGui::PopStyleColor();
+        }
+
+        ImGui::EndTabItem();
+      }
+
+      if (ImGui::BeginTabItem("Diagnostics")) {
+        ImGui::Text("Chrome Trace Capture");
+        ImGui::Spacing();
+
+        bool tracing = Trace::IsEnabled();
+        if (ImGui::Checkbox("Record Trace", &tracing)) {
+          if (tracing) {
+            Trace::Start();
+          } else {
+            Trace::Stop();
+          }
+        }
+        ImGui::Text("Events: %llu", static_cast<unsigned long long>(Trace::GetEventCount()));
+        if (Trace::GetDroppedEvents() > 0) {
+          ImGui::SameLine();
+          ImGui::PushStyleColor(ImGuiCol_Text, ImGui::Colors::WARNING);
+          ImGui::Text("(dropped %llu)", static_cast<unsigned long long>(Trace::GetDroppedEvents()));
+          ImGui::PopStyleColor();
+        }
+
+        if (ImGui::GradientButton("Write exports/trace.json", ImVec2(-1, 0))) {
+          traceStatus.clear();
+          try {
+            std::filesystem::create_directories("exports");
+            traceStatus = Trace::WriteJson("exports/trace.json")
+                              ? "Saved exports/trace.json"
+                              : "Failed to write exports/trace.json";
+          } catch (const std::exception& e) {
+            traceStatus = fmt::format("Failed to create exports directory: {}", e.what());
+          }
+        }
+        if (!traceStatus.empty()) {
+          ImGui::TextWrapped("%s", traceStatus.c_str());
+        }
+        ImGui::TextDisabled("Open the file in chrome://tracing or ui.perfetto.dev");
 
         ImGui::EndTabItem();
       }
@@ -1514,6 +2300,120 @@ void Gui::RenderSettingsModal() {
   }
 }
 
+void Gui::RenderProfilerOverlay() {
+  // One color per FramePhase
+  static const ImU32 phaseColors[FrameProfiler::PHASE_COUNT] = {
+    IM_COL32(231, 76, 60, 255),   // Events
+    IM_COL32(230, 126, 34, 255),  // Simulation
+    IM_COL32(241, 196, 15, 255),  // UI Update
+    IM_COL32(46, 204, 113, 255),  // Control Panel
+    IM_COL32(26, 188, 156, 255),  // Visualization
+    IM_COL32(52, 152, 219, 255),  // Properties
+    IM_COL32(155, 89, 182, 255),  // Status Panel
+    IM_COL32(236, 112, 160, 255), // ImGui::Render
+    IM_COL32(149, 165, 166, 255), // RenderDrawData
+    IM_COL32(127, 140, 141, 255), // Present
+    IM_COL32(60, 90, 120, 255),   // Frame Limiter
+    IM_COL32(80, 80, 90, 255),    // Other
+  };
+
+  const ImGuiIO& io = ImGui::GetIO();
+  ImGui::SetNextWindowPos(ImVec2(io.DisplaySize.x - 20.0f, 60.0f), ImGuiCond_FirstUseEver, ImVec2(1.0f, 0.0f));
+  ImGui::SetNextWindowSize(ImVec2(560, 420), ImGuiCond_FirstUseEver);
+  ImGui::SetNextWindowBgAlpha(0.9f);
+  if (!ImGui::Begin("Frame Profiler", &showProfiler, ImGuiWindowFlags_NoFocusOnAppearing)) {
+    ImGui::End();
+    return;
+  }
+  if (profiler.GetFrameCount() == 0) {
+    ImGui::Text("Collecting frames...");
+    ImGui::End();
+    return;
+  }
+
+  const FrameProfiler::Percentiles& percentiles = profiler.GetPercentiles();
+  ImGui::Text("Frame: %.2f ms | p50 %.2f | p95 %.2f | p99 %.2f ms",
+              profiler.GetLastFrame().total_ms, percentiles.p50, percentiles.p95, percentiles.p99);
+
+  // Stacked frame-time graph, newest frame on the right
+  const float budgetMs = 1000.0f / 60.0f;
+  const float scaleMs = std::max(percentiles.p99 * 1.25f, budgetMs * 1.25f);
+  ImDrawList* draw_list = ImGui::GetWindowDrawList();
+  ImVec2 graphPos = ImGui::GetCursorScreenPos();
+  ImVec2 graphSize(ImGui::GetContentRegionAvail().x, 150.0f);
+  ImVec2 graphEnd(graphPos.x + graphSize.x, graphPos.y + graphSize.y);
+  draw_list->AddRectFilled(graphPos, graphEnd, IM_COL32(20, 20, 25, 200));
+
+  const size_t frameCount = profiler.GetFrameCount();
+  const float barWidth = graphSize.x / FrameProfiler::HISTORY_SIZE;
+  const float xStart = graphEnd.x - frameCount * barWidth;
+  for (size_t i = 0; i < frameCount; ++i) {
+    const FrameProfiler::Frame& frame = profiler.GetFrame(i);
+    float x = xStart + i * barWidth;
+    float y = graphEnd.y;
+    for (size_t p = 0; p < FrameProfiler::PHASE_COUNT; ++p) {
+      float height = std::min(frame.phase_ms[p] / scaleMs * graphSize.y, y - graphPos.y);
+      if (height <= 0.0f) continue;
+      draw_list->AddRectFilled(ImVec2(x, y - height), ImVec2(x + std::max(barWidth - 1.0f, 1.0f), y),
+                               phaseColors[p]);
+      y -= height;
+    }
+  }
+
+  // 60 FPS budget line
+  float budgetY = graphEnd.y - budgetMs / scaleMs * graphSize.y;
+  draw_list->AddLine(ImVec2(graphPos.x, budgetY), ImVec2(graphEnd.x, budgetY),
+                     IM_COL32(255, 255, 255, 120), 1.0f);
+  draw_list->AddText(ImVec2(graphPos.x + 4, budgetY - ImGui::GetFontSize()),
+                     IM_COL32(255, 255, 255, 160), "16.7 ms");
+
+  ImGui::Dummy(graphSize);
+
+  // Breakdown of the frame under the mouse
+  if (ImGui::IsItemHovered()) {
+    ImVec2 mouse = ImGui::GetMousePos();
+    int index = static_cast<int>((mouse.x - xStart) / barWidth);
+    if (index >= 0 && index < static_cast<int>(frameCount)) {
+      const FrameProfiler::Frame& frame = profiler.GetFrame(index);
+      ImGui::BeginTooltip();
+      ImGui::Text("Frame: %.2f ms", frame.total_ms);
+      for (size_t p = 0; p < FrameProfiler::PHASE_COUNT; ++p) {
+        ImGui::Text("%s: %.3f ms", FrameProfiler::PhaseName(static_cast<FramePhase>(p)), frame.phase_ms[p]);
+      }
+      ImGui::EndTooltip();
+    }
+  }
+
+  // Legend with the last and mean time of every phase
+  ImGui::Spacing();
+  ImGui::Columns(3, "ProfilerPhases", false);
+  ImGui::Text("Phase");
+  ImGui::NextColumn();
+  ImGui::Text("Last (ms)");
+  ImGui::NextColumn();
+  ImGui::Text("Mean (ms)");
+  ImGui::NextColumn();
+  ImGui::Separator();
+  const FrameProfiler::Frame& last = profiler.GetLastFrame();
+  for (size_t p = 0; p < FrameProfiler::PHASE_COUNT; ++p) {
+    ImVec2 swatch = ImGui::GetCursorScreenPos();
+    float side = ImGui::GetFontSize() * 0.7f;
+    draw_list->AddRectFilled(ImVec2(swatch.x, swatch.y + side * 0.25f),
+                             ImVec2(swatch.x + side, swatch.y + side * 1.25f), phaseColors[p]);
+    ImGui::Dummy(ImVec2(side, 0));
+    ImGui::SameLine();
+    ImGui::Text("%s", FrameProfiler::PhaseName(static_cast<FramePhase>(p)));
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", last.phase_ms[p]);
+    ImGui::NextColumn();
+    ImGui::Text("%.3f", profiler.GetPhaseMeans()[p]);
+    ImGui::NextColumn();
+  }
+  ImGui::Columns(1);
+
+  ImGui::End();
+}
+
 void Gui::RenderAboutModal() {
   if (showAbout && !ImGui::IsPopupOpen("About")) {
     ImGui::OpenPopup("About");
@@ -1564,15 +2464,92 @@ void Gui::RenderAboutModal() {
   }
 }
 
+bool Gui::ShouldIdle() const {
+#ifdef __EMSCRIPTEN__
+  // The browser drives the loop; blocking would stall the page
+  return false;
+#else
+  // Transient animations still need frames; the perpetual pulse and glow
+  // effects freeze while paused
+  const bool animating = !isInitialAnimationComplete || themeChanged || showThemeNotification;
+  // So are the progress and result of exports and recordings
+  const bool exporting =
+      wavExportRunning || csvRecorder.IsRecording() || wavRecorder.IsRecording();
+  return paused && !animating && !exporting && SDL_GetTicks() - lastEventTicks > IDLE_DELAY_MS;
+#endif
+}
+
 void Gui::Run() {
-  ProcessEvents();
-  Update();
+  TRACE_SCOPE("Gui::Run");
+  if (ShouldIdle()) {
+    // Sleep until input arrives; the event stays queued for ProcessEvents.
+    // On timeout no frame is generated at all.
+    const bool woken = SDL_WaitEventTimeout(nullptr, IDLE_WAIT_MS) == 1;
+    profiler.DiscardFrame();
+    if (!woken) return;
+  }
+
+  profiler.BeginFrame();
+  {
+    FrameProfiler::Scope scope(profiler, FramePhase::EVENTS);
+    ProcessEvents();
+  }
+  {
+    FrameProfiler::Scope scope(profiler, FramePhase::SIMULATION);
+    AdvanceChannelBank();
+  }
+  {
+    FrameProfiler::Scope scope(profiler, FramePhase::UI_UPDATE);
+    Update();
+  }
   Render();
+  // Before the new rate reaches the simulation and the recorders
+  StopRecordingOnRateChange(csvRecorder, "csv", csvStatus);
+  StopRecordingOnRateChange(wavRecorder, "wav", wavStatus);
+
+  FrameProfiler::Scope scope(profiler, FramePhase::FRAME_LIMITER);
+  frameLimiter.Wait();
+}
+
+void Gui::ApplyFramePacing() {
+  const bool vsync = vsyncEnabled && !benchmarkMode;
+  const bool capped = frameCapEnabled && !benchmarkMode;
+#ifdef __EMSCRIPTEN__
+  // The browser paces the loop: requestAnimationFrame is its V-Sync, and a
+  // timeout-driven loop implements the cap or runs uncapped
+  if (capped) {
+    emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT, 1000 / frameCapFps);
+  } else if (vsync) {
+    emscripten_set_main_loop_timing(EM_TIMING_RAF, 1);
+  } else {
+    emscripten_set_main_loop_timing(EM_TIMING_SETTIMEOUT, 0);
+  }
+#else
+  vsyncApplied = SDL_RenderSetVSync(renderer, vsync ? 1 : 0) == 0;
+  if (!vsyncApplied) {
+    fmt::print("Failed to change V-Sync: {}\n", SDL_GetError());
+  }
+  frameLimiter.SetTargetFps(capped ? frameCapFps : 0.0);
+#endif
+}
+
+std::string Gui::GetFramePacingName() const {
+  if (benchmarkMode) return "Uncapped (benchmark)";
+  std::string name = vsyncEnabled ? "V-Sync" : "Uncapped";
+  if (frameCapEnabled) {
+    name = vsyncEnabled ? fmt::format("V-Sync, capped at {} FPS", frameCapFps)
+                        : fmt::format("Capped at {} FPS", frameCapFps);
+  }
+  return name;
 }
 
 void Gui::Cleanup() {
   fmt::print("Starting cleanup...\n");
 
+  if (csvRecorder.IsRecording()) ToggleRecording(csvRecorder, "csv");
+  if (wavRecorder.IsRecording()) ToggleRecording(wavRecorder, "wav");
+  if (wavExportThread.joinable()) wavExportThread.join();
+
   ImGui_ImplSDLRenderer2_Shutdown();
   ImGui_ImplSDL2_Shutdown();
   ImGui::DestroyContext();
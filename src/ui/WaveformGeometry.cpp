@@ -0,0 +1,59 @@
+#include "WaveformGeometry.hpp"
+
+#include <algorithm>
+
+const std::vector<ImVec2>& WaveformGeometry::Build(
+    const SampleView& values, const MinMaxPyramid& pyramid, ImVec2 canvas_pos,
+    ImVec2 canvas_size, float center_y, float scale_y) {
+  points_.clear();
+  if (values.empty()) return points_;
+
+  const size_t columns =
+      std::max<size_t>(static_cast<size_t>(canvas_size.x), 2);
+  decimated_ = values.size() > 2 * columns;
+
+  if (!decimated_) {
+    const float scale_x =
+        canvas_size.x /
+        static_cast<float>(std::max<size_t>(values.size() - 1, 1));
+    points_.reserve(values.size());
+    size_t i = 0;
+    values.ForEach([&](float v) {
+      points_.emplace_back(canvas_pos.x + i++ * scale_x,
+                           center_y - v * scale_y);
+    });
+    return points_;
+  }
+
+  UpdateEnvelope(values, pyramid, columns);
+  const float column_width = canvas_size.x / static_cast<float>(columns - 1);
+  points_.reserve(2 * columns);
+  for (size_t c = 0; c < columns; ++c) {
+    const float x = canvas_pos.x + c * column_width;
+    const float y_max = center_y - envelope_[c].max * scale_y;
+    const float y_min = center_y - envelope_[c].min * scale_y;
+    // Alternate max->min and min->max so consecutive columns connect
+    if (c % 2 == 0) {
+      points_.emplace_back(x, y_max);
+      points_.emplace_back(x, y_min);
+    } else {
+      points_.emplace_back(x, y_min);
+      points_.emplace_back(x, y_max);
+    }
+  }
+  return points_;
+}
+
+void WaveformGeometry::UpdateEnvelope(const SampleView& values,
+                                      const MinMaxPyramid& pyramid,
+                                      size_t columns) {
+  if (values.version == envelope_version_ && envelope_.size() == columns) {
+    return;
+  }
+  envelope_.resize(columns);
+  for (size_t c = 0; c < columns; ++c) {
+    envelope_[c] = pyramid.Query(values, c * values.size() / columns,
+                                 (c + 1) * values.size() / columns);
+  }
+  envelope_version_ = values.version;
+}
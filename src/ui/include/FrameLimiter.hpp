@@ -0,0 +1,34 @@
+#pragma once
+
+#include <chrono>
+
+// Caps the frame rate with a sleep-and-spin wait.
+//
+// OS sleeps can overshoot by a scheduler tick, so Wait() sleeps until
+// SPIN_MARGIN before the deadline and busy-waits the rest. Deadlines
+// advance by exactly one period per frame, so the average rate matches the
+// target; a frame that overruns restarts the schedule instead of bursting
+// to catch up.
+class FrameLimiter {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr std::chrono::microseconds SPIN_MARGIN{1500};
+
+  // Frames per second; 0 or less disables the limiter
+  void SetTargetFps(double fps);
+  double GetTargetFps() const { return target_fps_; }
+  bool IsEnabled() const { return target_fps_ > 0.0; }
+
+  // Block until the next frame is due
+  void Wait();
+
+  // Time spent in the last Wait(), sleeping and spinning
+  double GetLastWaitMs() const { return last_wait_ms_; }
+
+ private:
+  double target_fps_ = 0.0;
+  Clock::duration period_{};
+  Clock::time_point next_{};
+  double last_wait_ms_ = 0.0;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include "Trace.hpp"
+
+// Parts of a frame that are timed separately. OTHER is whatever the frame
+// spent outside the instrumented phases (layout, NewFrame, vsync waits
+// outside Present, ...).
+enum class FramePhase {
+  EVENTS = 0,
+  SIMULATION,
+  UI_UPDATE,
+  CONTROL_PANEL,
+  VISUALIZATION,
+  PROPERTIES_PANEL,
+  STATUS_PANEL,
+  IMGUI_RENDER,
+  RENDER_DRAW_DATA,
+  PRESENT,
+  FRAME_LIMITER,
+  OTHER,
+  COUNT
+};
+
+// Per-frame phase timings with a rolling history.
+//
+// BeginFrame() closes the previous frame, whose length is the time between
+// the two calls, and starts a new one. Phases are timed with Scope objects;
+// a phase may be entered several times per frame and its times add up. The
+// history keeps the last HISTORY_SIZE frames, and the frame-time
+// percentiles are recomputed once per frame.
+class FrameProfiler {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr size_t HISTORY_SIZE = 240;
+  static constexpr size_t PHASE_COUNT = static_cast<size_t>(FramePhase::COUNT);
+
+  struct Frame {
+    std::array<float, PHASE_COUNT> phase_ms{};
+    float total_ms = 0.f;
+  };
+
+  struct Percentiles {
+    float p50 = 0.f;
+    float p95 = 0.f;
+    float p99 = 0.f;
+  };
+
+  // Times the enclosing block as part of `phase`, and records it as a
+  // trace event while tracing is enabled
+  class Scope {
+   public:
+    Scope(FrameProfiler& profiler, FramePhase phase)
+        : profiler_(profiler),
+          phase_(phase),
+          start_(Clock::now()),
+          trace_(PhaseName(phase)) {}
+    ~Scope() { profiler_.Add(phase_, Clock::now() - start_); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+   private:
+    FrameProfiler& profiler_;
+    FramePhase phase_;
+    Clock::time_point start_;
+    Trace::Scope trace_;
+  };
+
+  FrameProfiler();
+
+  void BeginFrame();
+  // Drop the frame in progress, e.g. after idling; the next BeginFrame()
+  // starts a new frame without recording one
+  void DiscardFrame() { started_ = false; }
+  void Add(FramePhase phase, Clock::duration elapsed);
+
+  // Completed frames, i = 0 is the oldest
+  size_t GetFrameCount() const { return count_; }
+  const Frame& GetFrame(size_t i) const;
+  const Frame& GetLastFrame() const { return GetFrame(count_ - 1); }
+
+  // Frame-time percentiles over the history
+  const Percentiles& GetPercentiles() const { return percentiles_; }
+  // Mean time per phase over the history
+  const std::array<float, PHASE_COUNT>& GetPhaseMeans() const { return means_; }
+
+  static const char* PhaseName(FramePhase phase);
+
+ private:
+  void UpdateSummary();
+
+  std::vector<Frame> frames_;  // Ring of HISTORY_SIZE frames
+  size_t next_ = 0;
+  size_t count_ = 0;
+
+  Frame current_;
+  Clock::time_point frame_start_;
+  bool started_ = false;
+
+  Percentiles percentiles_;
+  std::array<float, PHASE_COUNT> means_{};
+  std::vector<float> sort_scratch_;
+};
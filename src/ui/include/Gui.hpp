@@ -1,5 +1,8 @@
 #pragma once
+#include <atomic>
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 #ifdef __EMSCRIPTEN__
 #include <SDL.h>
@@ -7,7 +10,16 @@
 #include <SDL2/SDL.h>
 #endif
 
+#include "ChannelBank.hpp"
 #include "CoreLogic.hpp"
+#include "FrameLimiter.hpp"
+#include "FrameProfiler.hpp"
+#include "SampleRecorder.hpp"
+#include "Simulation.hpp"
+#include "SpectrumAnalyzer.hpp"
+#include "ThreadPool.hpp"
+#include "WavWriter.hpp"
+#include "WaveformGeometry.hpp"
 #include "imgui.h"
 #include "imgui_impl_sdl2.h"
 #include "imgui_impl_sdlrenderer2.h"
@@ -50,6 +62,10 @@ class Gui {
   void Update();
   void Render();
   void TogglePause() { paused = !paused; };
+  // Optional; enables simulation thread statistics in the status panel
+  void SetSimulation(Simulation* simulation) { simulation_ = simulation; };
+  // Phase timings of the frame loop; the caller times its own work with it
+  FrameProfiler& GetProfiler() { return profiler; };
 
   // New UI rendering methods
   void RenderMainInterface();
@@ -60,12 +76,18 @@ class Gui {
   void RenderStatusPanel();
   void RenderSettingsModal();
   void RenderAboutModal();
+  void RenderProfilerOverlay();
 
   // Content rendering methods
   void RenderControlPanelContent();
   void RenderVisualizationContent();
   void RenderPropertiesPanelContent();
   void RenderStatusPanelContent();
+  void RenderWaveformPlot();
+  void RenderSpectrumPlot();
+  void RenderChannelsPlot();
+  void RenderPartialsEditor();
+  void RenderModulationEditor();
 
   // Panel management methods
   void ResetPanelSizes();
@@ -89,6 +111,35 @@ class Gui {
   void PushSliderThemeColors();
   void PopThemeColors(int count);
 
+  // Start or stop streaming samples to exports/samples_<time>.<extension>
+  void ToggleRecording(SampleRecorder& recorder, const char* extension);
+  // Stop a recording whose sample rate no longer matches the simulation,
+  // since its file describes a single rate; `status` tells the user why
+  void StopRecordingOnRateChange(SampleRecorder& recorder, const char* extension,
+                                 std::string& status);
+  // Restart the main wave's noise, in CoreLogic and the simulation thread
+  void ReseedNoise(uint64_t seed);
+  // Error line of a recorder whose writes failed
+  void RenderRecorderFailure(const SampleRecorder& recorder);
+  // Start rendering wavDuration seconds of the current configuration to a
+  // WAV file on its own thread (synchronously in the web build)
+  void RenderWavExport();
+  // Progress and result of that render, once per frame
+  void UpdateWavExport();
+  // exports/<prefix>_<time>.<extension>; empty if the directory is unusable
+  std::string MakeExportPath(const char* prefix, const char* extension);
+
+  // Generate the bank samples due since the last frame
+  void AdvanceChannelBank();
+
+  // Apply the V-Sync, frame cap and benchmark mode settings
+  void ApplyFramePacing();
+  std::string GetFramePacingName() const;
+
+  // Paused with no recent input and no transient animation: Run() then
+  // blocks for input instead of rendering
+  bool ShouldIdle() const;
+
   inline bool IsRunning() const { return running; }
   inline bool IsPaused() const { return paused; }
   inline void LoadSystemFonts() {
@@ -113,6 +164,14 @@ class Gui {
   float sidebarAnimationOffset = 0.0f;
   bool isInitialAnimationComplete = false;
 
+  // Idle rendering: while paused with no export or recording running,
+  // keep rendering for IDLE_DELAY_MS after the last input so hover states
+  // and pending results settle, then wait for events in slices of
+  // IDLE_WAIT_MS
+  static constexpr Uint32 IDLE_DELAY_MS = 500;
+  static constexpr int IDLE_WAIT_MS = 100;
+  Uint32 lastEventTicks = 0;
+
   // UI state variables
   bool showSettings = false;
   bool showAbout = false;
@@ -125,6 +184,70 @@ class Gui {
   bool enableAnimations = true;
   bool enableGlassEffect = true;
 
+  // Frame phase timings, shown in the profiler overlay
+  FrameProfiler profiler;
+  bool showProfiler = false;
+  std::string traceStatus;
+
+  // Frame pacing, edited in Settings > Performance
+  bool vsyncEnabled = true;
+  bool vsyncApplied = true;
+  bool frameCapEnabled = false;
+  int frameCapFps = 120;
+  bool benchmarkMode = false;  // No V-Sync and no cap
+  FrameLimiter frameLimiter;
+
+  // Persistent vertex buffers for the waveform polyline
+  WaveformGeometry waveGeometry;
+
+  // Spectrum view; the analyzer runs the FFT on its own thread
+  SpectrumAnalyzer spectrumAnalyzer;
+  SpectrumResult spectrum;
+  std::vector<ImVec2> spectrumPoints;
+  int spectrumSizeIndex = 6;  // 64 << 6 = 4096 points
+  int spectrumWindow = static_cast<int>(FftWindow::HANN);
+  bool spectrumLogFrequency = true;
+  uint64_t spectrumSubmittedVersion = UINT64_MAX;
+  size_t spectrumSubmittedSize = 0;
+  int spectrumSubmittedWindow = -1;
+
+  // Oscillator bank of the Channels view. It is generated on the UI thread
+  // with the worker pool, which is only started once the bank first runs.
+  static constexpr int MAX_SHOWN_CHANNELS = 32;
+  ChannelBank channelBank;
+  std::unique_ptr<ThreadPool> workerPool;
+  SampleClock channelClock;
+  bool channelBankEnabled = false;
+  float channelSampleRate = 1000.0f;
+  int channelViewMode = 0;  // 0 = overlay, 1 = stacked
+  int channelFirst = 0;     // Shown: [channelFirst, channelFirst + channelShown)
+  int channelShown = 8;
+  int channelEditIndex = 0;
+  float channelAdvanceMs = 0.0f;
+  double channelThroughput = 0.0;  // Samples per second of generation time
+  std::vector<WaveformGeometry> channelGeometry;
+
+  // Background CSV and WAV export
+  CsvRecorder csvRecorder;
+  WavRecorder wavRecorder;
+  std::string csvStatus;
+  int wavFormat = static_cast<int>(WavFormat::PCM16);
+  float wavDuration = 10.0f;
+  int wavSampleRate = 48000;
+  std::string wavStatus;
+
+  // Offline WAV render. The thread only writes the atomics and, before
+  // setting wavExportDone, the result; the UI thread reads the result after
+  // joining.
+  std::thread wavExportThread;
+  bool wavExportRunning = false;
+  std::atomic<bool> wavExportDone{false};
+  std::atomic<uint64_t> wavExportProgress{0};
+  uint64_t wavExportTotal = 0;
+  std::string wavExportPath;
+  bool wavExportOk = false;
+  WavRenderStats wavExportStats;
+
   // Theme management variables
   int currentThemeIndex = 0;
   bool themeChanged = false;
@@ -152,4 +275,5 @@ class Gui {
 
   // Reference for depencency injection
   CoreLogic& core_logic_;
+  Simulation* simulation_ = nullptr;
 };
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "MinMaxPyramid.hpp"
+#include "SampleView.hpp"
+#include "imgui.h"
+
+// Builds the screen-space polyline for the waveform plot.
+//
+// Short histories become one vertex per sample. Histories with more than
+// two samples per pixel column become a min/max envelope with two vertices
+// per column, alternating max/min so neighbouring columns connect. The
+// vertex and envelope buffers persist between frames, and the envelope is
+// only recomputed when the history version or the canvas width changes.
+class WaveformGeometry {
+ public:
+  // Rebuild the polyline for `values` inside the given canvas. A value of v
+  // is drawn at center_y - v * scale_y.
+  const std::vector<ImVec2>& Build(const SampleView& values,
+                                   const MinMaxPyramid& pyramid,
+                                   ImVec2 canvas_pos, ImVec2 canvas_size,
+                                   float center_y, float scale_y);
+
+  const std::vector<ImVec2>& GetPoints() const { return points_; }
+  bool IsDecimated() const { return decimated_; }
+
+ private:
+  void UpdateEnvelope(const SampleView& values, const MinMaxPyramid& pyramid,
+                      size_t columns);
+
+  std::vector<ImVec2> points_;
+  std::vector<MinMax> envelope_;
+  uint64_t envelope_version_ = UINT64_MAX;
+  bool decimated_ = false;
+};
@@ -0,0 +1,84 @@
+// Block-size independence of the noise generator.
+//
+// The same seed must give bit-identical noise however the samples are
+// split into calls: one block, blocks of 1 and of 7, Add() onto silence,
+// and Next() per sample. Exits non-zero if any split differs.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "NoiseGenerator.hpp"
+
+namespace {
+
+constexpr size_t SAMPLES = 4800;
+constexpr uint64_t SEED = 12345;
+
+const char* NOISE_NAMES[] = {"uniform", "gaussian"};
+
+std::vector<float> FillInBlocks(NoiseType type, size_t block) {
+  NoiseGenerator noise(SEED);
+  std::vector<float> out(SAMPLES);
+  for (size_t i = 0; i < SAMPLES; i += block) {
+    noise.Fill(type, out.data() + i, std::min(block, SAMPLES - i));
+  }
+  return out;
+}
+
+std::vector<float> AddInBlocks(NoiseType type, size_t block) {
+  NoiseGenerator noise(SEED);
+  std::vector<float> out(SAMPLES, 0.0f);
+  for (size_t i = 0; i < SAMPLES; i += block) {
+    noise.Add(type, out.data() + i, std::min(block, SAMPLES - i), 1.0f);
+  }
+  return out;
+}
+
+std::vector<float> NextPerSample(NoiseType type) {
+  NoiseGenerator noise(SEED);
+  std::vector<float> out(SAMPLES);
+  for (float& value : out) value = noise.Next(type);
+  return out;
+}
+
+// Number of samples that differ from `expected` in any bit
+size_t CountDifferences(const std::vector<float>& expected,
+                        const std::vector<float>& actual) {
+  size_t differences = 0;
+  for (size_t i = 0; i < SAMPLES; ++i) {
+    if (std::memcmp(&expected[i], &actual[i], sizeof(float)) != 0) {
+      ++differences;
+    }
+  }
+  return differences;
+}
+
+}  // namespace
+
+int main() {
+  int failures = 0;
+  for (NoiseType type : {NoiseType::UNIFORM, NoiseType::GAUSSIAN}) {
+    const std::vector<float> expected = FillInBlocks(type, SAMPLES);
+    const struct {
+      const char* name;
+      std::vector<float> output;
+    } splits[] = {
+        {"fill 1", FillInBlocks(type, 1)},
+        {"fill 7", FillInBlocks(type, 7)},
+        {"add 1", AddInBlocks(type, 1)},
+        {"add 7", AddInBlocks(type, 7)},
+        {"add all", AddInBlocks(type, SAMPLES)},
+        {"next", NextPerSample(type)},
+    };
+    for (const auto& split : splits) {
+      const size_t differences = CountDifferences(expected, split.output);
+      std::printf("%-8s %-7s %zu of %zu samples differ %s\n",
+                  NOISE_NAMES[static_cast<int>(type)], split.name,
+                  differences, SAMPLES, differences == 0 ? "ok" : "FAILED");
+      if (differences != 0) ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}
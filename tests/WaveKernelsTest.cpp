@@ -0,0 +1,249 @@
+// Accuracy of the waveform kernels on every ISA this CPU supports.
+//
+// Each kernel is swept over start phases (small and near the top of the
+// accumulator range) and increments, and compared sample by sample against
+// the shape evaluated in double precision at the exact phase, and against
+// the scalar kernel. Sine and cosine must stay within SINE_MAX_ERROR. The
+// piecewise-linear shapes are exact up to the float phase of the lanes, so
+// samples within PHASE_TOLERANCE cycles of a jump are skipped.
+//
+// The band-limited square, triangle and sawtooth are held to the same
+// bounds more than one increment away from their edges, and at a high
+// fundamental must alias far less than the naive kernels. Exits non-zero
+// if any shape exceeds its bound.
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "WaveKernels.hpp"
+
+namespace {
+
+using WaveKernels::Isa;
+
+// Phase error of a float lane, with margin
+constexpr double PHASE_TOLERANCE = 1e-6;
+// Piecewise-linear shapes: a slope of at most 4 per cycle times the phase
+// tolerance, plus float rounding of the result
+constexpr double LINEAR_MAX_ERROR = 4 * PHASE_TOLERANCE + 1e-6;
+
+constexpr double START_PHASES[] = {0.0, 0.1234567, 0.75, 1000.3,
+                                   1048575.9};
+constexpr double INCREMENTS[] = {0.0,     1e-7, 440.0 / 48000.0, 0.1,
+                                 0.37891, 0.5,  0.87654, 3.25};
+constexpr size_t SAMPLES = 1003;  // Not a multiple of any lane count
+
+// Band-limited kernels are only corrected up to half a cycle per sample
+constexpr double BAND_LIMITED_INCREMENTS[] = {440.0 / 48000.0, 0.01, 0.1,
+                                              0.37};
+constexpr double ALIAS_INCREMENT = 0.37;
+constexpr size_t ALIAS_SAMPLES = 10000;
+// The band-limited kernels must alias less than this share of the naive
+// kernels' alias power
+constexpr double MAX_ALIAS_RATIO = 0.1;
+
+const char* WAVE_NAMES[] = {"sine",     "cosine",   "square",
+                            "triangle", "sawtooth", "composite"};
+
+double Wrap(double x) { return x - std::floor(x); }
+
+// Exact unit shape at phase t in [0, 1)
+double Reference(WaveType type, double t) {
+  switch (type) {
+    case WaveType::SINE:
+      break;
+    case WaveType::COSINE:
+      return std::cos(2.0 * M_PI * t);
+    case WaveType::SQUARE:
+      return t < 0.5 ? 1.0 : -1.0;
+    case WaveType::TRIANGLE:
+      return 1.0 - 4.0 * std::fabs(Wrap(t + 0.25) - 0.5);
+    case WaveType::SAWTOOTH:
+      return 2.0 * t - 1.0;
+    case WaveType::COMPOSITE:
+      break;  // The kernel is the fundamental
+  }
+  return std::sin(2.0 * M_PI * t);
+}
+
+// Whether t lies within PHASE_TOLERANCE of a jump of the shape
+bool NearJump(WaveType type, double t) {
+  auto near = [t](double edge) {
+    return std::fabs(Wrap(t - edge + 0.5) - 0.5) < PHASE_TOLERANCE;
+  };
+  switch (type) {
+    case WaveType::SQUARE:
+      return near(0.0) || near(0.5);
+    case WaveType::SAWTOOTH:
+      return near(0.0);
+    case WaveType::SINE:
+    case WaveType::COSINE:
+    case WaveType::TRIANGLE:
+    case WaveType::COMPOSITE:
+      break;
+  }
+  return false;
+}
+
+double Bound(WaveType type) {
+  switch (type) {
+    case WaveType::SINE:
+    case WaveType::COSINE:
+    case WaveType::COMPOSITE:
+      break;
+    case WaveType::SQUARE:
+    case WaveType::TRIANGLE:
+    case WaveType::SAWTOOTH:
+      return LINEAR_MAX_ERROR;
+  }
+  return WaveKernels::SINE_MAX_ERROR;
+}
+
+// Largest errors of one kernel against the exact shape and the scalar
+// kernel over the whole sweep
+struct Errors {
+  double exact = 0.0;
+  double scalar = 0.0;
+};
+
+Errors Measure(WaveType type, Isa isa) {
+  const WaveKernels::KernelFn kernel = WaveKernels::Get(type, isa);
+  const WaveKernels::KernelFn scalar = WaveKernels::Get(type, Isa::SCALAR);
+  std::vector<float> out(SAMPLES);
+  std::vector<float> expected(SAMPLES);
+  Errors errors;
+  for (double phase : START_PHASES) {
+    for (double increment : INCREMENTS) {
+      kernel(out.data(), SAMPLES, phase, increment, 1.0f);
+      scalar(expected.data(), SAMPLES, phase, increment, 1.0f);
+      for (size_t i = 0; i < SAMPLES; ++i) {
+        const double t =
+            Wrap(Wrap(phase) + Wrap(increment) * static_cast<double>(i));
+        if (NearJump(type, t)) continue;
+        errors.exact =
+            std::max(errors.exact, std::fabs(out[i] - Reference(type, t)));
+        errors.scalar = std::max(
+            errors.scalar, static_cast<double>(std::fabs(out[i] - expected[i])));
+      }
+    }
+  }
+  return errors;
+}
+
+// Whether t lies within `distance` cycles of a discontinuity of the shape
+// or of its slope, where the band-limited kernels add their residuals
+bool NearEdge(WaveType type, double t, double distance) {
+  auto near = [t, distance](double edge) {
+    return std::fabs(Wrap(t - edge + 0.5) - 0.5) < distance;
+  };
+  switch (type) {
+    case WaveType::SQUARE:
+      return near(0.0) || near(0.5);
+    case WaveType::TRIANGLE:
+      return near(0.25) || near(0.75);
+    case WaveType::SAWTOOTH:
+      return near(0.0);
+    case WaveType::SINE:
+    case WaveType::COSINE:
+    case WaveType::COMPOSITE:
+      break;
+  }
+  return false;
+}
+
+// Away from the edges a band-limited kernel is the naive shape, so the
+// exact comparison skips samples within one increment of an edge
+Errors MeasureBandLimited(WaveType type, Isa isa) {
+  const WaveKernels::KernelFn kernel = WaveKernels::GetBandLimited(type, isa);
+  const WaveKernels::KernelFn scalar =
+      WaveKernels::GetBandLimited(type, Isa::SCALAR);
+  std::vector<float> out(SAMPLES);
+  std::vector<float> expected(SAMPLES);
+  Errors errors;
+  for (double phase : START_PHASES) {
+    for (double increment : BAND_LIMITED_INCREMENTS) {
+      kernel(out.data(), SAMPLES, phase, increment, 1.0f);
+      scalar(expected.data(), SAMPLES, phase, increment, 1.0f);
+      for (size_t i = 0; i < SAMPLES; ++i) {
+        const double t = Wrap(Wrap(phase) + increment * static_cast<double>(i));
+        if (!NearEdge(type, t, increment + PHASE_TOLERANCE)) {
+          errors.exact =
+              std::max(errors.exact, std::fabs(out[i] - Reference(type, t)));
+        }
+        if (!NearJump(type, t)) {
+          errors.scalar = std::max(
+              errors.scalar,
+              static_cast<double>(std::fabs(out[i] - expected[i])));
+        }
+      }
+    }
+  }
+  return errors;
+}
+
+// Share of the power, without DC, that is not at the fundamental. At
+// ALIAS_INCREMENT every harmonic above the first lies beyond Nyquist, so
+// all of it is aliasing. ALIAS_SAMPLES holds whole cycles of every
+// harmonic, so the projection onto the fundamental is exact.
+double AliasFraction(WaveKernels::KernelFn kernel) {
+  std::vector<float> out(ALIAS_SAMPLES);
+  kernel(out.data(), ALIAS_SAMPLES, 0.1, ALIAS_INCREMENT, 1.0f);
+  double mean = 0.0;
+  for (float x : out) mean += x;
+  mean /= ALIAS_SAMPLES;
+  double power = 0.0;
+  double re = 0.0;
+  double im = 0.0;
+  for (size_t i = 0; i < ALIAS_SAMPLES; ++i) {
+    const double x = out[i] - mean;
+    const double angle = 2.0 * M_PI * ALIAS_INCREMENT * static_cast<double>(i);
+    power += x * x;
+    re += x * std::cos(angle);
+    im += x * std::sin(angle);
+  }
+  const double fundamental = 2.0 * (re * re + im * im) / ALIAS_SAMPLES;
+  return (power - fundamental) / power;
+}
+
+}  // namespace
+
+int main() {
+  int failures = 0;
+  for (Isa isa : {Isa::SCALAR, Isa::SSE2, Isa::AVX2}) {
+    if (!WaveKernels::IsSupported(isa)) {
+      std::printf("%-6s not supported, skipped\n", WaveKernels::IsaName(isa));
+      continue;
+    }
+    for (int t = 0; t <= static_cast<int>(WaveType::COMPOSITE); ++t) {
+      const WaveType type = static_cast<WaveType>(t);
+      const Errors errors = Measure(type, isa);
+      const double bound = Bound(type);
+      // Each path is within the bound of the exact shape, so two paths are
+      // within twice the bound of each other
+      const bool ok = errors.exact <= bound && errors.scalar <= 2.0 * bound;
+      std::printf("%-6s %-9s exact %.3g scalar %.3g bound %.3g %s\n",
+                  WaveKernels::IsaName(isa), WAVE_NAMES[t], errors.exact,
+                  errors.scalar, bound, ok ? "ok" : "FAILED");
+      if (!ok) ++failures;
+    }
+    for (WaveType type :
+         {WaveType::SQUARE, WaveType::TRIANGLE, WaveType::SAWTOOTH}) {
+      const int t = static_cast<int>(type);
+      const Errors errors = MeasureBandLimited(type, isa);
+      const double naive_alias = AliasFraction(WaveKernels::Get(type, isa));
+      const double alias =
+          AliasFraction(WaveKernels::GetBandLimited(type, isa));
+      const bool ok = errors.exact <= LINEAR_MAX_ERROR &&
+                      errors.scalar <= 2.0 * LINEAR_MAX_ERROR &&
+                      alias <= MAX_ALIAS_RATIO * naive_alias;
+      std::printf(
+          "%-6s %-9s polyblep exact %.3g scalar %.3g alias %.3g naive %.3g "
+          "%s\n",
+          WaveKernels::IsaName(isa), WAVE_NAMES[t], errors.exact,
+          errors.scalar, alias, naive_alias, ok ? "ok" : "FAILED");
+      if (!ok) ++failures;
+    }
+  }
+  return failures == 0 ? 0 : 1;
+}